@@ -1,5 +1,5 @@
 
-#include <unordered_map>
+#include <vector>
 #include <iostream>
 
 #include "dbcppp-tiny/network.h"
@@ -40,6 +40,7 @@ void receive_frame_data(can_frame* frame)
      *  [...]
      */
     frame->can_id = 1;
+    frame->can_dlc = 8;
     *reinterpret_cast<uint64_t*>(frame->data) = 0;
     // set mux_switch_value to 3 (m3)
     frame->data[0] |= 3;
@@ -56,28 +57,21 @@ int main()
         return -1;
     }
 
-    std::unordered_map<uint64_t, const dbcppp::IMessage *> messages;
-    for (const dbcppp::IMessage& msg : net->Messages())
-    {
-        messages.insert(std::make_pair(msg.Id(), &msg));
-    }
     can_frame frame;
     while (1)
     {
         receive_frame_data(&frame);
-        auto iter = messages.find(frame.can_id);
-        if (iter != messages.end())
+        const dbcppp::IMessage* msg = net->FindMessage(frame.can_id);
+        if (msg != nullptr)
         {
-            const dbcppp::IMessage* msg = iter->second;
             std::cout << "Received Message: " << msg->Name() << "\n";
-            for (const dbcppp::ISignal& sig : msg->Signals())
+            std::vector<std::size_t> indices(msg->Signals_Size());
+            std::vector<double> values(msg->Signals_Size());
+            std::size_t n = msg->DecodeActive(frame.data, frame.can_dlc, indices.data(), values.data());
+            for (std::size_t i = 0; i < n; i++)
             {
-                const dbcppp::ISignal* mux_sig = msg->MuxSignal();
-                if (sig.MultiplexerIndicator() != dbcppp::ISignal::EMultiplexer::MuxValue ||
-                    (mux_sig && mux_sig->Decode(frame.data) == sig.MultiplexerSwitchValue()))
-                {
-                    std::cout << "\t" << sig.Name() << "=" << sig.RawToPhys(sig.Decode(frame.data)) << sig.Unit() << "\n";
-                }
+                const dbcppp::ISignal& sig = msg->Signals_Get(indices[i]);
+                std::cout << "\t" << sig.Name() << "=" << values[i] << sig.Unit() << "\n";
             }
         }
     }
@@ -22,7 +22,11 @@ enum class ParseErrorCode {
     InvalidMessageFormat,
     InvalidFloatFormat,
     InvalidStringFormat,
-    MemoryAllocationFailed
+    MemoryAllocationFailed,
+    // loading a network: the file couldn't be read or parsed (details are logged)
+    LoadFailed,
+    // loading a network: caller provided storage is too small
+    CapacityExceeded
 };
 
 // Parse error with code, message, and location
@@ -1,10 +1,13 @@
 
 #pragma once
 
-#include <functional>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 
 namespace dbcppp
 {
+    // Random access iterator over the i-th elements of an interface's *_Get(i) accessor
     template <class T>
     class Iterator
     {
@@ -15,43 +18,65 @@ namespace dbcppp
         using value_type        = T;
         using pointer           = const value_type*;
         using reference         = const value_type&;
-        using get_t             = std::function<reference (std::size_t)>;
+        using get_t             = reference (*)(const void* owner, std::size_t i);
 
-        Iterator(get_t get, std::size_t i)
-            : _get(get)
+        Iterator(const void* owner, get_t get, std::size_t i)
+            : _owner(owner)
+            , _get(get)
             , _i(i)
         {}
         reference operator*() const
         {
-            return _get(_i);
+            return _get(_owner, _i);
         }
         pointer operator->() const
         {
-            return &_get(_i);
+            return &_get(_owner, _i);
+        }
+        reference operator[](difference_type o) const
+        {
+            return _get(_owner, _i + o);
         }
         self_t& operator++()
         {
             _i++;
             return *this;
         }
-        self_t operator+(std::size_t o)
+        self_t operator++(int)
+        {
+            self_t old = *this;
+            _i++;
+            return old;
+        }
+        self_t& operator--()
+        {
+            _i--;
+            return *this;
+        }
+        self_t operator--(int)
+        {
+            self_t old = *this;
+            _i--;
+            return old;
+        }
+        self_t operator+(difference_type o) const
         {
-            return {_get, _i + o};
+            return {_owner, _get, _i + o};
         }
-        self_t operator-(std::size_t o)
+        self_t operator-(difference_type o) const
         {
-            return {_get, _i + o};
+            return {_owner, _get, _i - o};
         }
-        difference_type operator-(const self_t& rhs)
+        difference_type operator-(const self_t& rhs) const
         {
-            return _i - rhs._i;
+            return difference_type(_i) - difference_type(rhs._i);
         }
-        self_t& operator+=(std::size_t o)
+        self_t& operator+=(difference_type o)
         {
             _i += o;
             return *this;
         }
-        self_t& operator-=(std::size_t o)
+        self_t& operator-=(difference_type o)
         {
             _i -= o;
             return *this;
@@ -65,8 +90,25 @@ namespace dbcppp
         {
             return !(*this == rhs);
         }
+        bool operator<(const self_t& rhs) const
+        {
+            return _i < rhs._i;
+        }
+        bool operator>(const self_t& rhs) const
+        {
+            return rhs < *this;
+        }
+        bool operator<=(const self_t& rhs) const
+        {
+            return !(rhs < *this);
+        }
+        bool operator>=(const self_t& rhs) const
+        {
+            return !(*this < rhs);
+        }
 
     private:
+        const void* _owner;
         get_t _get;
         std::size_t _i;
     };
@@ -78,11 +120,11 @@ namespace dbcppp
             : _begin(begin)
             , _end(end)
         {}
-        Iterator& begin()
+        Iterator begin() const
         {
             return _begin;
         }
-        Iterator& end()
+        Iterator end() const
         {
             return _end;
         }
@@ -91,12 +133,181 @@ namespace dbcppp
         Iterator _begin;
         Iterator _end;
     };
+
+    // Random access iterator over objects implementing T which lie stride bytes apart
+    template <class T>
+    class ObjectSpanIterator
+    {
+    public:
+        using self_t            = ObjectSpanIterator<T>;
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = T;
+        using pointer           = const value_type*;
+        using reference         = const value_type&;
+
+        ObjectSpanIterator(const T* p, std::size_t stride)
+            : _p(reinterpret_cast<const char*>(p))
+            , _stride(stride)
+        {}
+        reference operator*() const
+        {
+            return *reinterpret_cast<pointer>(_p);
+        }
+        pointer operator->() const
+        {
+            return reinterpret_cast<pointer>(_p);
+        }
+        reference operator[](difference_type o) const
+        {
+            return *reinterpret_cast<pointer>(_p + o * difference_type(_stride));
+        }
+        self_t& operator++()
+        {
+            _p += _stride;
+            return *this;
+        }
+        self_t operator++(int)
+        {
+            self_t old = *this;
+            _p += _stride;
+            return old;
+        }
+        self_t& operator--()
+        {
+            _p -= _stride;
+            return *this;
+        }
+        self_t operator--(int)
+        {
+            self_t old = *this;
+            _p -= _stride;
+            return old;
+        }
+        self_t operator+(difference_type o) const
+        {
+            self_t result = *this;
+            return result += o;
+        }
+        self_t operator-(difference_type o) const
+        {
+            self_t result = *this;
+            return result -= o;
+        }
+        difference_type operator-(const self_t& rhs) const
+        {
+            return (_p - rhs._p) / difference_type(_stride);
+        }
+        self_t& operator+=(difference_type o)
+        {
+            _p += o * difference_type(_stride);
+            return *this;
+        }
+        self_t& operator-=(difference_type o)
+        {
+            _p -= o * difference_type(_stride);
+            return *this;
+        }
+
+        bool operator==(const self_t& rhs) const
+        {
+            return _p == rhs._p;
+        }
+        bool operator!=(const self_t& rhs) const
+        {
+            return _p != rhs._p;
+        }
+        bool operator<(const self_t& rhs) const
+        {
+            return _p < rhs._p;
+        }
+        bool operator>(const self_t& rhs) const
+        {
+            return rhs._p < _p;
+        }
+        bool operator<=(const self_t& rhs) const
+        {
+            return !(rhs._p < _p);
+        }
+        bool operator>=(const self_t& rhs) const
+        {
+            return !(_p < rhs._p);
+        }
+
+    private:
+        const char* _p;
+        std::size_t _stride;
+    };
+    template <class T>
+    ObjectSpanIterator<T> operator+(typename ObjectSpanIterator<T>::difference_type o, const ObjectSpanIterator<T>& iter)
+    {
+        return iter + o;
+    }
+
+    // View of the contiguous array an implementation stores its T objects in (e.g. the signals of a
+    // message). The elements are of the implementation's type, which is larger than T, so the span
+    // carries the element size: iterating is a pointer increment, indexing a multiply-add, neither
+    // goes through a virtual call.
+    template <class T>
+    class ObjectSpan
+    {
+    public:
+        using iterator = ObjectSpanIterator<T>;
+        using const_iterator = iterator;
+
+        ObjectSpan() = default;
+        template <class U>
+        ObjectSpan(const U* first, std::size_t size)
+            : _first(first)
+            , _size(size)
+            , _stride(sizeof(U))
+        {
+            static_assert(std::is_base_of<T, U>::value, "elements have to implement T");
+        }
+
+        iterator begin() const
+        {
+            return {_first, _stride};
+        }
+        iterator end() const
+        {
+            return begin() + difference_type(_size);
+        }
+        std::size_t size() const
+        {
+            return _size;
+        }
+        bool empty() const
+        {
+            return _size == 0;
+        }
+        const T& operator[](std::size_t i) const
+        {
+            return begin()[difference_type(i)];
+        }
+        const T& front() const
+        {
+            return *begin();
+        }
+        const T& back() const
+        {
+            return begin()[difference_type(_size) - 1];
+        }
+
+    private:
+        using difference_type = typename iterator::difference_type;
+
+        const T* _first = nullptr;
+        std::size_t _size = 0;
+        std::size_t _stride = sizeof(T);
+    };
 }
 #define DBCPPP_MAKE_ITERABLE(ClassName, Name, Type)                                 \
     auto Name() const                                                               \
     {                                                                               \
-        auto get = std::bind(&ClassName::Name##_Get, this, std::placeholders::_1);  \
-        Iterator<Type> begin(get, 0);                                               \
-        Iterator<Type> end(get, Name##_Size());                                     \
+        auto get = [](const void* owner, std::size_t i) -> const Type&              \
+            { return static_cast<const ClassName*>(owner)->Name##_Get(i); };        \
+        Iterator<Type> begin(this, get, 0);                                         \
+        Iterator<Type> end(this, get, Name##_Size());                               \
         return Iterable(begin, end);                                                \
     }
@@ -47,11 +47,24 @@ namespace dbcppp
         virtual const ISignalGroup& SignalGroups_Get(std::size_t i) const = 0;
         virtual uint64_t SignalGroups_Size() const = 0;
         virtual const ISignal* MuxSignal() const = 0;
+
+        // Decodes every signal of the message in one pass using a decode plan compiled at load time.
+        // out receives Signals_Size() physical values in signal order (equal to RawToPhys(Decode(bytes))).
+        // Frames shorter than the bytes the plan reads are zero padded. Returns the number of values written.
+        virtual std::size_t DecodeAll(const void* bytes, std::size_t len, double* out) const noexcept = 0;
+        // Decodes only the signals active for the frame's multiplexer switch value: the non-multiplexed
+        // signals plus the MuxValue signals of the selected page, looked up in a table built at load time.
+        // With extended multiplexing (SG_MUL_VAL_) a signal is active when its switch is active and the switch's
+        // raw value lies in one of the signal's value ranges, which resolves cascaded and independent multiplexors.
+        // indices[k] receives the position of the k-th decoded signal in Signals(), values[k] its physical value.
+        // Both arrays need room for Signals_Size() entries. Returns the number of decoded signals.
+        virtual std::size_t DecodeActive(const void* bytes, std::size_t len, std::size_t* indices, double* values) const noexcept = 0;
         
         DBCPPP_MAKE_ITERABLE(IMessage, MessageTransmitters, std::string);
-        DBCPPP_MAKE_ITERABLE(IMessage, Signals, ISignal);
-        DBCPPP_MAKE_ITERABLE(IMessage, AttributeValues, IAttribute);
-        DBCPPP_MAKE_ITERABLE(IMessage, SignalGroups, ISignalGroup);
+        // views of the arrays the objects are stored in, iterating them doesn't go through *_Get
+        virtual ObjectSpan<ISignal> Signals() const = 0;
+        virtual ObjectSpan<IAttribute> AttributeValues() const = 0;
+        virtual ObjectSpan<ISignalGroup> SignalGroups() const = 0;
         
         virtual EErrorCode Error() const = 0;
     };
@@ -2,10 +2,13 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 #include <unordered_map>
 #include <map>
+#include <optional>
+#include <cstddef>
 
 #include "export.h"
 #include "iterator.h"
@@ -16,9 +19,25 @@
 #include "signal_type.h"
 #include "attribute_definition.h"
 #include "attribute.h"
+#include "dbc_parser_result.h"
 
 namespace dbcppp
 {
+    // Caller provided storage for INetwork::LoadDBCIntoStorage with a capacity fixed at compile
+    // time, e.g. a static NetworkStorage<256 * 1024>
+    template <std::size_t Capacity>
+    struct NetworkStorage
+    {
+        alignas(std::max_align_t) unsigned char bytes[Capacity];
+    };
+
+    // A signal and the message it belongs to, see INetwork::FindSignal
+    struct MessageSignal
+    {
+        const IMessage* message;
+        const ISignal* signal;
+    };
+
     class DBCPPP_API INetwork
     {
     public:
@@ -46,6 +65,61 @@ namespace dbcppp
             SignalFilter signal_filter = [](const std::string&, uint32_t) { return true; });
         static std::map<std::string, std::unique_ptr<INetwork>> LoadNetworkFromFile(const std::string& filename);
 
+        // Options for LoadDBCFromFile.
+        //
+        // Compile cache: with a cache_dir set, the network is stored there as a snapshot named
+        // after a hash of the DBC contents and filter_key, and later loads of the same contents
+        // map that snapshot instead of parsing. Filters are opaque callbacks, so filter_key must
+        // identify them: loads with different filters need different keys, loads with filters
+        // and an empty filter_key don't use the cache. Empty filters (the default) keep every
+        // message and signal. The directory must exist; failing to read or write the cache
+        // never fails the load.
+        //
+        // Arena: with arena_block_size set, the containers of the network (messages, signals,
+        // attributes, receivers, ...) are allocated from blocks of that size owned by the network
+        // and released together with it, instead of one heap block per container. Strings longer
+        // than the small string buffer of std::string are still allocated individually.
+        struct LoadOptions
+        {
+            std::string cache_dir;
+            std::string filter_key;
+            std::size_t arena_block_size = 0;
+        };
+        static std::unique_ptr<INetwork> LoadDBCFromFile(const char* filename,
+            const LoadOptions& options,
+            MessageFilter message_filter = nullptr,
+            SignalFilter signal_filter = nullptr);
+
+        // Static storage: like LoadDBCFromFile with an arena, but the containers of the network are
+        // placed in the caller's storage, which has to outlive the network. options.arena_block_size
+        // is ignored. Returns CapacityExceeded (the message names the size needed) if the storage is
+        // too small and LoadFailed if the file can't be loaded.
+        // Loading still allocates temporaries, the network object and strings longer than the small
+        // string buffer from the heap; once loaded, decoding a network never allocates.
+        static Result<std::unique_ptr<INetwork>> LoadDBCIntoStorage(const char* filename,
+            void* storage, std::size_t storage_size,
+            const LoadOptions& options,
+            MessageFilter message_filter = nullptr,
+            SignalFilter signal_filter = nullptr);
+        template <std::size_t Capacity>
+        static Result<std::unique_ptr<INetwork>> LoadDBCIntoStorage(const char* filename,
+            NetworkStorage<Capacity>& storage,
+            const LoadOptions& options,
+            MessageFilter message_filter = nullptr,
+            SignalFilter signal_filter = nullptr)
+        {
+            return LoadDBCIntoStorage(filename, storage.bytes, Capacity, options,
+                std::move(message_filter), std::move(signal_filter));
+        }
+
+        // Binary snapshot of a loaded network. Loading a snapshot maps the file and builds the
+        // network from its flat tables, skipping lexing, parsing and AST conversion.
+        // Snapshots are only valid for the library version and machine type that wrote them,
+        // LoadSnapshot returns nullptr for anything else (rebuild it from the DBC in that case).
+        // To decode straight from a snapshot without building the network, see ISnapshotView.
+        bool SaveSnapshot(const char* filename) const;
+        static std::unique_ptr<INetwork> LoadSnapshot(const char* filename);
+
 
         virtual ~INetwork() = default;
         virtual const std::string& Version() const = 0;
@@ -65,15 +139,107 @@ namespace dbcppp
         virtual const IAttribute& AttributeValues_Get(std::size_t i) const = 0;
         virtual uint64_t AttributeValues_Size() const = 0;
         
-        DBCPPP_MAKE_ITERABLE(INetwork, NewSymbols, std::string);
-        DBCPPP_MAKE_ITERABLE(INetwork, Nodes, INode);
-        DBCPPP_MAKE_ITERABLE(INetwork, ValueTables, IValueTable);
-        DBCPPP_MAKE_ITERABLE(INetwork, Messages, IMessage);
-        DBCPPP_MAKE_ITERABLE(INetwork, AttributeDefinitions, IAttributeDefinition);
-        DBCPPP_MAKE_ITERABLE(INetwork, AttributeDefaults, IAttribute);
-        DBCPPP_MAKE_ITERABLE(INetwork, AttributeValues, IAttribute);
+        // views of the arrays the objects are stored in, iterating them doesn't go through *_Get
+        virtual ObjectSpan<std::string> NewSymbols() const = 0;
+        virtual ObjectSpan<INode> Nodes() const = 0;
+        virtual ObjectSpan<IValueTable> ValueTables() const = 0;
+        virtual ObjectSpan<IMessage> Messages() const = 0;
+        virtual ObjectSpan<IAttributeDefinition> AttributeDefinitions() const = 0;
+        virtual ObjectSpan<IAttribute> AttributeDefaults() const = 0;
+        virtual ObjectSpan<IAttribute> AttributeValues() const = 0;
 
+        // Constant time: signals keep a reference to the message they are stored in.
+        // Returns nullptr if sig isn't a signal of one of this network's messages.
         virtual const IMessage* ParentMessage(const ISignal* sig) const = 0;
 
+        // Constant time lookup by CAN ID as it appears in the DBC (bit 31 set for extended IDs).
+        // Returns nullptr if the network has no message with this ID.
+        virtual const IMessage* FindMessage(uint64_t id) const = 0;
+
+        // Constant time lookups by name through hash tables built at load time.
+        // Returns the first message / node with this name or nullptr.
+        virtual const IMessage* FindMessageByName(std::string_view name) const = 0;
+        virtual const INode* FindNode(std::string_view name) const = 0;
+        // Every signal with this name (names are only unique within a message), in the order
+        // of Messages(); empty if there is none.
+        virtual ObjectSpan<MessageSignal> FindSignal(std::string_view name) const = 0;
+
+        static constexpr std::size_t npos = std::size_t(-1);
+        // ID of the attribute definition with this name, its position in AttributeDefinitions(),
+        // or npos. Resolve it once and use it for the constant time reads below.
+        virtual std::size_t AttributeId(std::string_view name) const = 0;
+        // The object's BA_ value of the attribute, else its BA_DEF_DEF_ default with enum values
+        // given as index like in BA_ values. nullptr if neither exists, the attribute isn't
+        // defined for the object's type or the object doesn't belong to this network.
+        virtual const IAttribute* GetAttribute(const INetwork& net, std::size_t attr_id) const = 0;
+        virtual const IAttribute* GetAttribute(const INode& node, std::size_t attr_id) const = 0;
+        virtual const IAttribute* GetAttribute(const IMessage& msg, std::size_t attr_id) const = 0;
+        virtual const IAttribute* GetAttribute(const ISignal& sig, std::size_t attr_id) const = 0;
+        // Typed reads of GetAttribute(): integers (INT, HEX and ENUM index) and floats convert
+        // into each other, GetAttributeString returns STRING values and the names of ENUM values.
+        template <class Object>
+        std::optional<int64_t> GetAttributeInt(const Object& object, std::size_t attr_id) const;
+        template <class Object>
+        std::optional<double> GetAttributeDouble(const Object& object, std::size_t attr_id) const;
+        template <class Object>
+        const std::string* GetAttributeString(const Object& object, std::size_t attr_id) const;
+
     };
+
+    template <class Object>
+    std::optional<int64_t> INetwork::GetAttributeInt(const Object& object, std::size_t attr_id) const
+    {
+        const IAttribute* attr = GetAttribute(object, attr_id);
+        if (attr == nullptr)
+        {
+            return std::nullopt;
+        }
+        if (auto value = std::get_if<int64_t>(&attr->Value()))
+        {
+            return *value;
+        }
+        if (auto value = std::get_if<double>(&attr->Value()))
+        {
+            return int64_t(*value);
+        }
+        return std::nullopt;
+    }
+    template <class Object>
+    std::optional<double> INetwork::GetAttributeDouble(const Object& object, std::size_t attr_id) const
+    {
+        const IAttribute* attr = GetAttribute(object, attr_id);
+        if (attr == nullptr)
+        {
+            return std::nullopt;
+        }
+        if (auto value = std::get_if<double>(&attr->Value()))
+        {
+            return *value;
+        }
+        if (auto value = std::get_if<int64_t>(&attr->Value()))
+        {
+            return double(*value);
+        }
+        return std::nullopt;
+    }
+    template <class Object>
+    const std::string* INetwork::GetAttributeString(const Object& object, std::size_t attr_id) const
+    {
+        const IAttribute* attr = GetAttribute(object, attr_id);
+        if (attr == nullptr)
+        {
+            return nullptr;
+        }
+        if (auto value = std::get_if<std::string>(&attr->Value()))
+        {
+            return value;
+        }
+        auto index = std::get_if<int64_t>(&attr->Value());
+        auto enum_type = std::get_if<IAttributeDefinition::ValueTypeEnum>(&AttributeDefinitions_Get(attr_id).ValueType());
+        if (index && enum_type && *index >= 0 && uint64_t(*index) < enum_type->values.size())
+        {
+            return &enum_type->values[std::size_t(*index)];
+        }
+        return nullptr;
+    }
 }
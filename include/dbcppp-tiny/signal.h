@@ -108,11 +108,20 @@ namespace dbcppp
         inline raw_t Decode(const void* bytes) const noexcept { return _decode(this, bytes); }
 
         inline double RawToPhys(raw_t raw) const noexcept { return _raw_to_phys(this, raw); }
+
+        /// \brief Decodes this signal from n frames at once
+        ///
+        /// Frame i starts at frames + i * stride and has to fulfill the same size requirements as Decode().
+        /// out receives n raw values (like Decode()) or n physical values (like RawToPhys(Decode())).
+        /// Uses AVX2/SSE4.1 kernels selected at runtime when available, otherwise a scalar loop.
+        virtual void DecodeBatch(const void* frames, std::size_t stride, std::size_t n, raw_t* out) const noexcept = 0;
+        virtual void DecodeBatch(const void* frames, std::size_t stride, std::size_t n, double* out) const noexcept = 0;
         
         DBCPPP_MAKE_ITERABLE(ISignal, Receivers, std::string);
-        DBCPPP_MAKE_ITERABLE(ISignal, ValueEncodingDescriptions, IValueEncodingDescription);
-        DBCPPP_MAKE_ITERABLE(ISignal, AttributeValues, IAttribute);
-        DBCPPP_MAKE_ITERABLE(ISignal, SignalMultiplexerValues, ISignalMultiplexerValue);
+        // views of the arrays the objects are stored in, iterating them doesn't go through *_Get
+        virtual ObjectSpan<IValueEncodingDescription> ValueEncodingDescriptions() const = 0;
+        virtual ObjectSpan<IAttribute> AttributeValues() const = 0;
+        virtual ObjectSpan<ISignalMultiplexerValue> SignalMultiplexerValues() const = 0;
 
     protected:
         // instead of using virtuals dynamic dispatching use function pointers
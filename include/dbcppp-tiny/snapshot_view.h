@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+#include "export.h"
+
+namespace dbcppp
+{
+    // Read-only view of a snapshot written by INetwork::SaveSnapshot, used directly from memory
+    // the caller keeps alive, typically a read-only mapping of the snapshot file. Unlike
+    // INetwork::LoadSnapshot no network objects are built: Open() validates the snapshot once,
+    // afterwards lookups and decoding work on its flat tables and never allocate.
+    // Messages are addressed by their index in the snapshot, which is the order of
+    // INetwork::Messages() of the network that was saved.
+    class DBCPPP_API ISnapshotView
+    {
+    public:
+        static constexpr std::size_t npos = std::size_t(-1);
+
+        // data must be 8 byte aligned (a mapping or heap buffer) and outlive the view.
+        // Returns nullptr if data isn't a snapshot of this library version and machine type.
+        static std::unique_ptr<ISnapshotView> Open(std::string_view data);
+
+        virtual ~ISnapshotView() = default;
+        virtual uint64_t Messages_Size() const noexcept = 0;
+        // index of the message with this CAN ID or npos, binary search over the stored id table
+        virtual std::size_t FindMessage(uint64_t id) const noexcept = 0;
+        virtual uint64_t MessageId(std::size_t i) const noexcept = 0;
+        // strings point into the snapshot data
+        virtual std::string_view MessageName(std::size_t i) const noexcept = 0;
+        virtual uint64_t Signals_Size(std::size_t i) const noexcept = 0;
+        virtual std::string_view SignalName(std::size_t i, std::size_t j) const noexcept = 0;
+        // Decodes every signal of message i like IMessage::DecodeAll, out needs room for
+        // Signals_Size(i) values. Returns the number of values written, 0 if len is too short.
+        virtual std::size_t DecodeAll(std::size_t i, const void* bytes, std::size_t len, double* out) const noexcept = 0;
+    };
+}
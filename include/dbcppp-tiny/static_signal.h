@@ -0,0 +1,212 @@
+#pragma once
+
+#include <ratio>
+#include <cstdint>
+#include <cstring>
+
+#include "signal.h"
+
+namespace dbcppp
+{
+    // how a signal is read from the frame, see SignalLayout
+    enum class Alignment
+        : uint8_t
+    {
+        size_inbetween_first_64_bit,
+        signal_exceeds_64_bit_size_but_signal_fits_into_64_bit,
+        signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit,
+        // integer signal read with one 32 bit load at byte_pos, only with DBCPPP_COMPACT_DESCRIPTORS
+        signal_fits_into_32_bit
+    };
+
+    // Position of a signal in the 64 bit load(s) the decoder does: the load starts at byte_pos,
+    // is shifted by fixed_start_bit_0 and masked, signals spanning 9 bytes combine it with the
+    // following byte shifted by fixed_start_bit_1. Computed the same way for runtime signals
+    // (SignalImpl) and StaticSignal.
+    struct SignalLayout
+    {
+        Alignment alignment;
+        uint64_t byte_pos;
+        uint64_t fixed_start_bit_0;
+        uint64_t fixed_start_bit_1;
+        uint64_t mask;
+
+        static constexpr SignalLayout Create(uint64_t start_bit, uint64_t bit_size, ISignal::EByteOrder byte_order) noexcept
+        {
+            SignalLayout layout{Alignment::size_inbetween_first_64_bit, start_bit / 8, 0, 0, 0};
+            // CAN signals can be upto 64 bits in size but doing a shift of more than 63 bytes is undefined behavior
+            layout.mask = (1ull << (bit_size - 1ull) << 1ull) - 1;
+
+            uint64_t nbytes = byte_order == ISignal::EByteOrder::LittleEndian
+                ? (start_bit % 8 + bit_size + 7) / 8
+                : (bit_size + (7 - start_bit % 8) + 7) / 8;
+            // check whether the data is in the first 8 bytes
+            // so we can optimize out one memory access
+            if (layout.byte_pos + nbytes <= 8)
+            {
+                layout.alignment = Alignment::size_inbetween_first_64_bit;
+                if (byte_order == ISignal::EByteOrder::LittleEndian)
+                {
+                    layout.fixed_start_bit_0 = start_bit;
+                }
+                else
+                {
+                    layout.fixed_start_bit_0 = (8 * (7 - (start_bit / 8))) + (start_bit % 8) - (bit_size - 1);
+                }
+            }
+            // check whether we can align the data on 64 bit, otherwise whether the data fits into one uint64_t
+            else if (layout.byte_pos % 8 + nbytes <= 8 || nbytes <= 8)
+            {
+                layout.alignment = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
+                if (layout.byte_pos % 8 + nbytes <= 8)
+                {
+                    // align the byte pos on 64 bit
+                    layout.byte_pos -= layout.byte_pos % 8;
+                }
+                layout.fixed_start_bit_0 = start_bit - layout.byte_pos * 8;
+                if (byte_order == ISignal::EByteOrder::BigEndian)
+                {
+                    layout.fixed_start_bit_0 = (8 * (7 - (layout.fixed_start_bit_0 / 8))) + (layout.fixed_start_bit_0 % 8) - (bit_size - 1);
+                }
+            }
+            // we aren't able to align the data on 64 bit, and we aren't able to fit the data into one uint64_t
+            // so we have to compose the resulting value
+            else
+            {
+                layout.alignment = Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
+                if (byte_order == ISignal::EByteOrder::BigEndian)
+                {
+                    uint64_t nbits_last_byte = (7 - start_bit % 8) + bit_size - 64;
+                    layout.fixed_start_bit_0 = nbits_last_byte;
+                    layout.fixed_start_bit_1 = 8 - nbits_last_byte;
+                    layout.mask = (1ull << (start_bit % 8 + 57)) - 1;
+                }
+                else
+                {
+                    layout.fixed_start_bit_0 = start_bit - layout.byte_pos * 8;
+                    layout.fixed_start_bit_1 = 64 - start_bit % 8;
+                    uint64_t nbits_last_byte = bit_size + start_bit % 8 - 64;
+                    layout.mask = (1ull << nbits_last_byte) - 1ull;
+                }
+            }
+            return layout;
+        }
+    };
+
+    // Signal with its position and scaling fixed at compile time, for hot paths which decode a
+    // few known signals without going through the network:
+    //
+    //     using VehicleSpeed = StaticSignal<24, 16, ISignal::EByteOrder::LittleEndian,
+    //         ISignal::EValueType::Unsigned, ISignal::EExtendedValueType::Integer, std::ratio<1, 100>>;
+    //     double speed = VehicleSpeed::Phys(frame);
+    //
+    // Decode() returns the same raw value as ISignal::Decode of a signal created with these
+    // parameters, RawToPhys() scales in double precision like ISignal::RawToPhys (unless that is
+    // built with DBCPPP_COMPACT_DESCRIPTORS). Factor and Offset are std::ratio, frames have to
+    // hold at least extent bytes.
+    template <uint64_t StartBit, uint64_t BitSize, ISignal::EByteOrder ByteOrder, ISignal::EValueType ValueType,
+        ISignal::EExtendedValueType ExtendedValueType = ISignal::EExtendedValueType::Integer,
+        class Factor = std::ratio<1>, class Offset = std::ratio<0>>
+    class StaticSignal
+    {
+    public:
+        static_assert(BitSize >= 1 && BitSize <= 64, "signals are 1 to 64 bits long");
+        static_assert(ExtendedValueType != ISignal::EExtendedValueType::Float || BitSize == 32, "float signals are 32 bits long");
+        static_assert(ExtendedValueType != ISignal::EExtendedValueType::Double || BitSize == 64, "double signals are 64 bits long");
+
+        static constexpr uint64_t start_bit = StartBit;
+        static constexpr uint64_t bit_size = BitSize;
+        static constexpr ISignal::EByteOrder byte_order = ByteOrder;
+        static constexpr ISignal::EValueType value_type = ValueType;
+        static constexpr ISignal::EExtendedValueType extended_value_type = ExtendedValueType;
+        static constexpr SignalLayout layout = SignalLayout::Create(StartBit, BitSize, ByteOrder);
+        // bytes of the frame Decode() reads
+        static constexpr uint64_t extent =
+            layout.alignment == Alignment::size_inbetween_first_64_bit ? 8 :
+            layout.alignment == Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit ? layout.byte_pos + 8 :
+            layout.byte_pos + 9;
+        static constexpr double factor = double(Factor::num) / double(Factor::den);
+        static constexpr double offset = double(Offset::num) / double(Offset::den);
+
+        static constexpr ISignal::raw_t Decode(const uint8_t* bytes) noexcept
+        {
+            constexpr uint8_t fsb0 = uint8_t(layout.fixed_start_bit_0 & 63);
+            constexpr uint8_t fsb1 = uint8_t(layout.fixed_start_bit_1 & 63);
+            uint64_t data = Load(bytes + (layout.alignment == Alignment::size_inbetween_first_64_bit ? 0 : layout.byte_pos));
+            if constexpr (layout.alignment == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+            {
+                uint64_t data1 = bytes[layout.byte_pos + 8];
+                if constexpr (ByteOrder == ISignal::EByteOrder::BigEndian)
+                {
+                    data = ((data & layout.mask) << fsb0) | (data1 >> fsb1);
+                }
+                else
+                {
+                    data = (data >> fsb0) | ((data1 & layout.mask) << fsb1);
+                }
+                if constexpr (ExtendedValueType != ISignal::EExtendedValueType::Integer)
+                {
+                    return data;
+                }
+            }
+            else
+            {
+                if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Double)
+                {
+                    return data;
+                }
+                data = (data >> fsb0) & layout.mask;
+                if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Float)
+                {
+                    return data;
+                }
+            }
+            if constexpr (ValueType == ISignal::EValueType::Signed)
+            {
+                constexpr uint8_t sign_shift = uint8_t((64 - BitSize) & 63);
+                data = uint64_t(int64_t(data << sign_shift) >> sign_shift);
+            }
+            return data;
+        }
+        static double RawToPhys(ISignal::raw_t raw) noexcept
+        {
+            if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Double)
+            {
+                double value;
+                std::memcpy(&value, &raw, sizeof(value));
+                return value * factor + offset;
+            }
+            else if constexpr (ExtendedValueType == ISignal::EExtendedValueType::Float)
+            {
+                uint32_t raw32 = uint32_t(raw);
+                float value;
+                std::memcpy(&value, &raw32, sizeof(value));
+                return double(value) * factor + offset;
+            }
+            else if constexpr (ValueType == ISignal::EValueType::Signed)
+            {
+                return double(int64_t(raw)) * factor + offset;
+            }
+            else
+            {
+                return double(raw) * factor + offset;
+            }
+        }
+        static double Phys(const uint8_t* bytes) noexcept
+        {
+            return RawToPhys(Decode(bytes));
+        }
+
+    private:
+        // byte wise load, independent of host byte order and alignment, compilers fold it into one load
+        static constexpr uint64_t Load(const uint8_t* p) noexcept
+        {
+            uint64_t v = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                v |= uint64_t(p[i]) << (ByteOrder == ISignal::EByteOrder::BigEndian ? 8 * (7 - i) : 8 * i);
+            }
+            return v;
+        }
+    };
+}
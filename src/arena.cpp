@@ -0,0 +1,88 @@
+#include <new>
+#include "arena.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    thread_local Arena* current_arena = nullptr;
+}
+
+Arena::Arena(std::size_t block_size) noexcept
+    : _block_size(block_size < 2 * header_size ? 2 * header_size : block_size)
+{}
+Arena::Arena(void* buffer, std::size_t size) noexcept
+    : _cursor(static_cast<char*>(buffer))
+    , _end(static_cast<char*>(buffer) + size)
+    , _block_size(default_block_size)
+    , _buffer(static_cast<char*>(buffer))
+{}
+Arena::~Arena()
+{
+    while (_blocks)
+    {
+        Block* next = _blocks->next;
+        ::operator delete(_blocks);
+        _blocks = next;
+    }
+}
+char* Arena::NewBlock(std::size_t size, bool make_current)
+{
+    Block* block = static_cast<Block*>(::operator new(size));
+    _block_count++;
+    _capacity += size;
+    if (make_current || !_blocks)
+    {
+        block->next = _blocks;
+        _blocks = block;
+    }
+    else
+    {
+        // linked behind the current block so its remaining space stays usable
+        block->next = _blocks->next;
+        _blocks->next = block;
+    }
+    return reinterpret_cast<char*>(block) + header_size;
+}
+void* Arena::Allocate(std::size_t size, std::size_t align)
+{
+    auto align_up = [align](const char* p)
+    {
+        return reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(p) + align - 1) & ~uintptr_t(align - 1));
+    };
+    if (_cursor)
+    {
+        char* p = align_up(_cursor);
+        if (p <= _end && std::size_t(_end - p) >= size)
+        {
+            _used += p + size - _cursor;
+            _cursor = p + size;
+            return p;
+        }
+    }
+    std::size_t needed = size + align - 1;
+    _used += needed;
+    if (needed > _block_size / 4)
+    {
+        // large requests get a block of their own
+        return align_up(NewBlock(header_size + needed, false));
+    }
+    char* p = align_up(NewBlock(_block_size, true));
+    _end = reinterpret_cast<char*>(_blocks) + _block_size;
+    _cursor = p + size;
+    return p;
+}
+Arena* Arena::Current() noexcept
+{
+    return current_arena;
+}
+
+ArenaScope::ArenaScope(Arena& arena) noexcept
+    : _previous(current_arena)
+{
+    current_arena = &arena;
+}
+ArenaScope::~ArenaScope()
+{
+    current_arena = _previous;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace dbcppp
+{
+    // Monotonic allocator for the object graph of a network. Memory is handed out from a few
+    // large blocks and only released all at once when the arena is destroyed, so a loaded
+    // network costs a handful of heap blocks instead of one per container.
+    //
+    // Containers pick the arena up through ArenaAllocator: while an ArenaScope is active on
+    // the current thread, every ArenaVector constructed on that thread allocates from its
+    // arena. Outside of any scope ArenaAllocator is a plain heap allocator.
+    //
+    // An arena over a caller provided buffer allocates from that buffer only. Requests which
+    // don't fit anymore are still served from the heap so the caller can finish and clean up,
+    // but mark the arena Exhausted().
+    class Arena
+    {
+    public:
+        static constexpr std::size_t default_block_size = 16 * 1024;
+
+        explicit Arena(std::size_t block_size = default_block_size) noexcept;
+        Arena(void* buffer, std::size_t size) noexcept;
+        ~Arena();
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* Allocate(std::size_t size, std::size_t align);
+
+        // heap blocks owned and their total size
+        std::size_t BlockCount() const noexcept
+        {
+            return _block_count;
+        }
+        std::size_t Capacity() const noexcept
+        {
+            return _capacity;
+        }
+        // bytes handed out, including alignment padding
+        std::size_t Used() const noexcept
+        {
+            return _used;
+        }
+        // a buffer backed arena had to fall back to the heap
+        bool Exhausted() const noexcept
+        {
+            return _buffer && _block_count != 0;
+        }
+
+        // arena of the innermost ArenaScope on this thread or nullptr
+        static Arena* Current() noexcept;
+
+    private:
+        struct Block
+        {
+            Block* next;
+        };
+        static constexpr std::size_t header_size = (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+        char* NewBlock(std::size_t size, bool make_current);
+
+        Block* _blocks = nullptr;
+        char* _cursor = nullptr;
+        char* _end = nullptr;
+        std::size_t _block_size;
+        std::size_t _block_count = 0;
+        std::size_t _capacity = 0;
+        std::size_t _used = 0;
+        char* _buffer = nullptr;
+    };
+
+    // Makes arena the current arena of this thread for the lifetime of the scope
+    class ArenaScope
+    {
+    public:
+        explicit ArenaScope(Arena& arena) noexcept;
+        ~ArenaScope();
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator=(const ArenaScope&) = delete;
+
+    private:
+        Arena* _previous;
+    };
+
+    // Allocator binding a container to the arena current at its construction. Copies of a
+    // container bind to the arena current at the time of the copy, moves keep the allocator,
+    // so a container never outlives the memory it points to as long as arena backed objects
+    // are owned by whoever owns the arena.
+    template <class T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        ArenaAllocator() noexcept
+            : _arena(Arena::Current())
+        {}
+        explicit ArenaAllocator(Arena* arena) noexcept
+            : _arena(arena)
+        {}
+        template <class U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+            : _arena(other.GetArena())
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            if (_arena)
+            {
+                return static_cast<T*>(_arena->Allocate(n * sizeof(T), alignof(T)));
+            }
+            return std::allocator<T>().allocate(n);
+        }
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            if (!_arena)
+            {
+                std::allocator<T>().deallocate(p, n);
+            }
+        }
+        ArenaAllocator select_on_container_copy_construction() const noexcept
+        {
+            return ArenaAllocator();
+        }
+
+        Arena* GetArena() const noexcept
+        {
+            return _arena;
+        }
+
+    private:
+        Arena* _arena;
+    };
+    template <class T, class U>
+    inline bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept
+    {
+        return lhs.GetArena() == rhs.GetArena();
+    }
+    template <class T, class U>
+    inline bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept
+    {
+        return lhs.GetArena() != rhs.GetArena();
+    }
+
+    template <class T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
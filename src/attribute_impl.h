@@ -2,6 +2,7 @@
 #pragma once
 
 #include "dbcppp-tiny/attribute.h"
+#include "string_pool.h"
 
 namespace dbcppp
 {
@@ -16,7 +17,7 @@ namespace dbcppp
         virtual const value_t& Value() const override;
 
     private:
-        std::string _name;
+        PooledString _name;
         IAttributeDefinition::EObjectType _object_type;
         IAttribute::value_t _value;
     };
@@ -0,0 +1,130 @@
+#include <vector>
+#include "dbcppp-tiny/network.h"
+#include "attribute_index.h"
+
+using namespace dbcppp;
+
+void AttributeIndex::Build(const INetwork& net)
+{
+    using EObjectType = IAttributeDefinition::EObjectType;
+
+    _definitions.clear();
+    _first_signal_row.clear();
+    _defaults.clear();
+    for (auto& table : _tables)
+    {
+        table = Table();
+    }
+
+    auto definitions = net.AttributeDefinitions();
+    std::vector<std::string_view> names;
+    names.reserve(definitions.size());
+    _definitions.reserve(definitions.size());
+    for (const auto& def : definitions)
+    {
+        names.push_back(def.Name());
+        Table& table = _tables[std::size_t(def.ObjectType())];
+        _definitions.push_back({def.ObjectType(), uint32_t(table.columns++)});
+    }
+    _names.Build(names);
+
+    _tables[std::size_t(EObjectType::Network)].rows = 1;
+    _tables[std::size_t(EObjectType::Node)].rows = net.Nodes().size();
+    _tables[std::size_t(EObjectType::Message)].rows = net.Messages().size();
+    std::size_t n_signals = 0;
+    _first_signal_row.reserve(net.Messages().size());
+    for (const auto& msg : net.Messages())
+    {
+        _first_signal_row.push_back(uint32_t(n_signals));
+        n_signals += msg.Signals().size();
+    }
+    _tables[std::size_t(EObjectType::Signal)].rows = n_signals;
+
+    // the defaults fill whole columns, _defaults must not reallocate once they are referenced
+    std::vector<const IAttribute*> default_of(_definitions.size(), nullptr);
+    _defaults.reserve(net.AttributeDefaults().size());
+    for (const auto& attr : net.AttributeDefaults())
+    {
+        std::size_t id = Find(attr.Name());
+        if (id == npos)
+        {
+            continue;
+        }
+        const IAttributeDefinition& def = definitions[id];
+        IAttribute::value_t value = attr.Value();
+        auto enum_type = std::get_if<IAttributeDefinition::ValueTypeEnum>(&def.ValueType());
+        auto enum_name = std::get_if<std::string>(&value);
+        if (enum_type && enum_name)
+        {
+            for (std::size_t i = 0; i < enum_type->values.size(); i++)
+            {
+                if (enum_type->values[i] == *enum_name)
+                {
+                    value = int64_t(i);
+                    break;
+                }
+            }
+        }
+        _defaults.emplace_back(std::string(attr.Name()), def.ObjectType(), std::move(value));
+        default_of[id] = &_defaults.back();
+    }
+    for (auto& table : _tables)
+    {
+        table.cells.assign(table.rows * table.columns, nullptr);
+    }
+    for (std::size_t id = 0; id < _definitions.size(); id++)
+    {
+        if (default_of[id] == nullptr)
+        {
+            continue;
+        }
+        Table& table = _tables[std::size_t(_definitions[id].object_type)];
+        for (std::size_t row = 0; row < table.rows; row++)
+        {
+            table.cells[row * table.columns + _definitions[id].column] = default_of[id];
+        }
+    }
+
+    // values given for an object override the defaults, for repeated values the last one wins
+    auto set = [&](EObjectType type, std::size_t row, const IAttribute& attr)
+    {
+        std::size_t id = Find(attr.Name());
+        if (id == npos || _definitions[id].object_type != type)
+        {
+            return;
+        }
+        Table& table = _tables[std::size_t(type)];
+        table.cells[row * table.columns + _definitions[id].column] = &attr;
+    };
+    for (const auto& attr : net.AttributeValues())
+    {
+        set(EObjectType::Network, 0, attr);
+    }
+    std::size_t row = 0;
+    for (const auto& node : net.Nodes())
+    {
+        for (const auto& attr : node.AttributeValues())
+        {
+            set(EObjectType::Node, row, attr);
+        }
+        row++;
+    }
+    row = 0;
+    std::size_t signal_row = 0;
+    for (const auto& msg : net.Messages())
+    {
+        for (const auto& attr : msg.AttributeValues())
+        {
+            set(EObjectType::Message, row, attr);
+        }
+        for (const auto& sig : msg.Signals())
+        {
+            for (const auto& attr : sig.AttributeValues())
+            {
+                set(EObjectType::Signal, signal_row, attr);
+            }
+            signal_row++;
+        }
+        row++;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+#include "dbcppp-tiny/attribute_definition.h"
+#include "attribute_impl.h"
+#include "name_index.h"
+#include "arena.h"
+
+namespace dbcppp
+{
+    class INetwork;
+
+    // Immutable (object, attribute definition) -> attribute table, built once at load time.
+    // Per object type one dense table with a row per object (the signals of all messages in
+    // the order of Messages()) and a column per definition of that type. Every cell holds the
+    // object's BA_ value or, if it has none, the definition's BA_DEF_DEF_ default, so a read
+    // is an index computation without any string compare. Defaults of enum attributes are
+    // stored as the index of the enum value like BA_ values are.
+    class AttributeIndex
+    {
+    public:
+        static constexpr std::size_t npos = std::size_t(-1);
+
+        void Build(const INetwork& net);
+
+        // attribute definition ID (position in AttributeDefinitions()) of name or npos
+        std::size_t Find(std::string_view name) const noexcept
+        {
+            uint32_t id = _names.FindFirst(name);
+            return id == NameIndex::npos ? npos : id;
+        }
+        inline const IAttribute* Get(IAttributeDefinition::EObjectType type, std::size_t row, std::size_t id) const noexcept
+        {
+            if (id >= _definitions.size() || _definitions[id].object_type != type)
+            {
+                return nullptr;
+            }
+            const Table& table = _tables[std::size_t(type)];
+            if (row >= table.rows)
+            {
+                return nullptr;
+            }
+            return table.cells[row * table.columns + _definitions[id].column];
+        }
+        // row of the first signal of message i in the signal table
+        std::size_t FirstSignalRow(std::size_t i) const noexcept
+        {
+            return _first_signal_row[i];
+        }
+
+    private:
+        struct Definition
+        {
+            IAttributeDefinition::EObjectType object_type;
+            uint32_t column;
+        };
+        struct Table
+        {
+            std::size_t rows = 0;
+            std::size_t columns = 0;
+            ArenaVector<const IAttribute*> cells;
+        };
+
+        NameIndex _names;
+        ArenaVector<Definition> _definitions;
+        // indexed by EObjectType
+        std::array<Table, 4> _tables;
+        ArenaVector<uint32_t> _first_signal_row;
+        // BA_DEF_DEF_ values with the object type of their definition and enum values resolved
+        ArenaVector<AttributeImpl> _defaults;
+    };
+}
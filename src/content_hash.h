@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <string_view>
+
+namespace dbcppp
+{
+    // Non-cryptographic 64 bit hash of a buffer (the XXH64 algorithm, reading words in native
+    // byte order). Four independent lanes consume 32 bytes per round, so hashing a DBC file
+    // costs a small fraction of lexing it. Used to key compiled networks in the load cache.
+    class ContentHash
+    {
+    public:
+        static uint64_t Hash(std::string_view data, uint64_t seed = 0) noexcept
+        {
+            const char* p = data.data();
+            const char* end = p + data.size();
+            uint64_t h;
+            if (data.size() >= 32)
+            {
+                uint64_t v1 = seed + p1 + p2;
+                uint64_t v2 = seed + p2;
+                uint64_t v3 = seed;
+                uint64_t v4 = seed - p1;
+                for (; end - p >= 32; p += 32)
+                {
+                    v1 = Round(v1, Read64(p));
+                    v2 = Round(v2, Read64(p + 8));
+                    v3 = Round(v3, Read64(p + 16));
+                    v4 = Round(v4, Read64(p + 24));
+                }
+                h = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+                h = MergeRound(h, v1);
+                h = MergeRound(h, v2);
+                h = MergeRound(h, v3);
+                h = MergeRound(h, v4);
+            }
+            else
+            {
+                h = seed + p5;
+            }
+            h += uint64_t(data.size());
+            for (; end - p >= 8; p += 8)
+            {
+                h ^= Round(0, Read64(p));
+                h = Rotl(h, 27) * p1 + p4;
+            }
+            if (end - p >= 4)
+            {
+                uint32_t w;
+                std::memcpy(&w, p, sizeof(w));
+                h ^= uint64_t(w) * p1;
+                h = Rotl(h, 23) * p2 + p3;
+                p += 4;
+            }
+            for (; p != end; ++p)
+            {
+                h ^= uint64_t(uint8_t(*p)) * p5;
+                h = Rotl(h, 11) * p1;
+            }
+            h ^= h >> 33;
+            h *= p2;
+            h ^= h >> 29;
+            h *= p3;
+            h ^= h >> 32;
+            return h;
+        }
+
+    private:
+        static constexpr uint64_t p1 = 0x9E3779B185EBCA87ull;
+        static constexpr uint64_t p2 = 0xC2B2AE3D27D4EB4Full;
+        static constexpr uint64_t p3 = 0x165667B19E3779F9ull;
+        static constexpr uint64_t p4 = 0x85EBCA77C2B2AE63ull;
+        static constexpr uint64_t p5 = 0x27D4EB2F165667C5ull;
+
+        static inline uint64_t Rotl(uint64_t x, int r) noexcept
+        {
+            return (x << r) | (x >> (64 - r));
+        }
+        static inline uint64_t Read64(const char* p) noexcept
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        static inline uint64_t Round(uint64_t acc, uint64_t input) noexcept
+        {
+            acc += input * p2;
+            acc = Rotl(acc, 31);
+            return acc * p1;
+        }
+        static inline uint64_t MergeRound(uint64_t acc, uint64_t val) noexcept
+        {
+            acc ^= Round(0, val);
+            return acc * p1 + p4;
+        }
+    };
+}
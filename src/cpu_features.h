@@ -0,0 +1,50 @@
+#pragma once
+
+// Runtime CPU feature detection for the optional x86-64 decode kernels.
+// Kernels are compiled with __attribute__((target(...))) so the library itself
+// keeps running on any x86-64 CPU and other platforms only get the portable code.
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__)) && !defined(ESP_PLATFORM)
+#   define DBCPPP_X86_DISPATCH
+#endif
+
+namespace dbcppp
+{
+    inline bool CpuSupportsAvx2() noexcept
+    {
+#ifdef DBCPPP_X86_DISPATCH
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+        return supported;
+#else
+        return false;
+#endif
+    }
+    inline bool CpuSupportsSse41() noexcept
+    {
+#ifdef DBCPPP_X86_DISPATCH
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("sse4.1"));
+        return supported;
+#else
+        return false;
+#endif
+    }
+    inline bool CpuSupportsBmi2() noexcept
+    {
+#ifdef DBCPPP_X86_DISPATCH
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("bmi2"));
+        return supported;
+#else
+        return false;
+#endif
+    }
+    // pext/pdep are microcoded and much slower than a shift/mask sequence on AMD before Zen 3
+    inline bool CpuHasFastPext() noexcept
+    {
+#ifdef DBCPPP_X86_DISPATCH
+        static const bool fast = CpuSupportsBmi2() && !__builtin_cpu_is("amdfam15h") &&
+            !__builtin_cpu_is("znver1") && !__builtin_cpu_is("znver2");
+        return fast;
+#else
+        return false;
+#endif
+    }
+}
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include <variant>
 #include <cstdint>
 #include <algorithm>
+#include <cassert>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 namespace dbcppp {
 
@@ -81,27 +85,140 @@ enum class TokenType {
 
 struct Token {
     TokenType type;
-    std::string value;
+    // view into the lexer input, STRING tokens exclude the quotes but keep escape sequences
+    std::string_view value;
     size_t line;
     size_t column;
+    // STRING token contains \" or \\ escapes, text() resolves them
+    bool escaped;
     
-    Token(TokenType t, const std::string& v, size_t l, size_t c)
-        : type(t), value(v), line(l), column(c) {}
+    Token()
+        : type(TokenType::END_OF_FILE), line(0), column(0), escaped(false) {}
+    Token(TokenType t, std::string_view v, size_t l, size_t c, bool e = false)
+        : type(t), value(v), line(l), column(c), escaped(e) {}
+
+    // Owned copy of the token text with escape sequences resolved
+    std::string text() const {
+        if (!escaped) {
+            return std::string(value);
+        }
+        std::string result;
+        result.reserve(value.size());
+        for (size_t i = 0; i < value.size(); i++) {
+            if (value[i] == '\\' && i + 1 < value.size() && (value[i + 1] == '"' || value[i + 1] == '\\')) {
+                i++;
+            }
+            result += value[i];
+        }
+        return result;
+    }
 };
 
+// Number conversions for token values without allocating or throwing.
+// The tryParse* functions convert the longest valid prefix and return std::nullopt if there
+// is none (no digit for integers, nothing strtod accepts for doubles). A leading '-' on
+// unsigned values wraps like strtoull, out of range integers saturate.
+inline std::optional<uint64_t> tryParseUnsigned(std::string_view s, int base = 10) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < s.size() && (s[i] == '-' || s[i] == '+')) {
+        negative = s[i] == '-';
+        i++;
+    }
+    if (base == 16 && i + 2 < s.size() && s[i] == '0' && (s[i + 1] == 'x' || s[i + 1] == 'X')) {
+        i += 2;
+    }
+    size_t first_digit = i;
+    uint64_t result = 0;
+    bool saturated = false;
+    for (; i < s.size(); i++) {
+        char ch = s[i];
+        unsigned digit;
+        if (ch >= '0' && ch <= '9') digit = unsigned(ch - '0');
+        else if (base == 16 && ch >= 'a' && ch <= 'f') digit = unsigned(ch - 'a' + 10);
+        else if (base == 16 && ch >= 'A' && ch <= 'F') digit = unsigned(ch - 'A' + 10);
+        else break;
+        if (saturated || result > (UINT64_MAX - digit) / unsigned(base)) {
+            saturated = true;
+            continue;
+        }
+        result = result * unsigned(base) + digit;
+    }
+    if (i == first_digit) {
+        return std::nullopt;
+    }
+    if (saturated) {
+        return UINT64_MAX;
+    }
+    return negative ? uint64_t(0) - result : result;
+}
+
+inline std::optional<int64_t> tryParseSigned(std::string_view s) {
+    bool negative = !s.empty() && s[0] == '-';
+    std::optional<uint64_t> magnitude = tryParseUnsigned(negative ? s.substr(1) : s);
+    if (!magnitude) {
+        return std::nullopt;
+    }
+    if (negative) {
+        return *magnitude > uint64_t(INT64_MAX) ? INT64_MIN : -int64_t(*magnitude);
+    }
+    return *magnitude > uint64_t(INT64_MAX) ? INT64_MAX : int64_t(*magnitude);
+}
+
+inline std::optional<double> tryParseDouble(std::string_view s) {
+    // strtod needs a terminated string, tokens are short enough for the stack
+    char buffer[64];
+    std::string heap;
+    const char* str = buffer;
+    if (s.size() < sizeof(buffer)) {
+        std::memcpy(buffer, s.data(), s.size());
+        buffer[s.size()] = '\0';
+    } else {
+        heap = std::string(s);
+        str = heap.c_str();
+    }
+    char* end = nullptr;
+    double result = std::strtod(str, &end);
+    if (end == str) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+// For tokens the lexer already classified as numbers: 0 if there's nothing to convert.
+inline uint64_t parseUnsigned(std::string_view s, int base = 10) {
+    return tryParseUnsigned(s, base).value_or(0);
+}
+inline int64_t parseSigned(std::string_view s) {
+    return tryParseSigned(s).value_or(0);
+}
+inline double parseDouble(std::string_view s) {
+    return tryParseDouble(s).value_or(0.0);
+}
+
+// The lexer doesn't copy its input, the buffer has to outlive the lexer.
+// Tokens are produced on demand through next()/peek(), only the lookahead
+// window is buffered so memory use doesn't grow with the input size.
 class DBCLexer {
+public:
+    // number of tokens peek() can look ahead
+    static constexpr size_t max_lookahead = 8;
+
 private:
-    std::string input_;
+    std::string_view input_;
     size_t pos_;
     size_t line_;
     size_t column_;
+    Token ring_[max_lookahead];
+    size_t ring_head_;
+    size_t ring_count_;
     
-    char peek() const {
+    char peekChar() const {
         if (pos_ >= input_.size()) return '\0';
         return input_[pos_];
     }
     
-    char peek(size_t offset) const {
+    char peekChar(size_t offset) const {
         if (pos_ + offset >= input_.size()) return '\0';
         return input_[pos_ + offset];
     }
@@ -119,23 +236,27 @@ private:
     }
     
     void skipWhitespace() {
-        while (std::isspace(peek())) {
+        while (std::isspace(peekChar())) {
             advance();
         }
     }
     
+    bool atComment() const {
+        return peekChar() == '/' && (peekChar(1) == '/' || peekChar(1) == '*');
+    }
+    
     void skipComment() {
-        if (peek() == '/' && peek(1) == '/') {
+        if (peekChar() == '/' && peekChar(1) == '/') {
             // Single line comment
             advance(); advance();
-            while (peek() != '\n' && peek() != '\0') {
+            while (peekChar() != '\n' && peekChar() != '\0') {
                 advance();
             }
-        } else if (peek() == '/' && peek(1) == '*') {
+        } else if (peekChar() == '/' && peekChar(1) == '*') {
             // Block comment
             advance(); advance();
-            while (peek() != '\0') {
-                if (peek() == '*' && peek(1) == '/') {
+            while (peekChar() != '\0') {
+                if (peekChar() == '*' && peekChar(1) == '/') {
                     advance(); advance();
                     break;
                 }
@@ -147,96 +268,93 @@ private:
     Token readNumber() {
         size_t start_line = line_;
         size_t start_col = column_;
-        std::string value;
+        size_t start = pos_;
         bool is_float = false;
-        bool is_hex = false;
         
         // Check for hex
-        if (peek() == '0' && (peek(1) == 'x' || peek(1) == 'X')) {
-            value += advance(); // 0
-            value += advance(); // x
-            is_hex = true;
-            while (std::isxdigit(peek())) {
-                value += advance();
+        if (peekChar() == '0' && (peekChar(1) == 'x' || peekChar(1) == 'X')) {
+            advance(); // 0
+            advance(); // x
+            while (std::isxdigit(peekChar())) {
+                advance();
             }
         } else {
             // Check for negative
-            if (peek() == '-') {
-                value += advance();
+            if (peekChar() == '-') {
+                advance();
             }
             
             // Read digits
-            while (std::isdigit(peek())) {
-                value += advance();
+            while (std::isdigit(peekChar())) {
+                advance();
             }
             
             // Check for decimal point
-            if (peek() == '.' && std::isdigit(peek(1))) {
+            if (peekChar() == '.' && std::isdigit(peekChar(1))) {
                 is_float = true;
-                value += advance(); // .
-                while (std::isdigit(peek())) {
-                    value += advance();
+                advance(); // .
+                while (std::isdigit(peekChar())) {
+                    advance();
                 }
             }
             
             // Check for scientific notation
-            if ((peek() == 'e' || peek() == 'E') && 
-                (std::isdigit(peek(1)) || 
-                 ((peek(1) == '+' || peek(1) == '-') && std::isdigit(peek(2))))) {
+            if ((peekChar() == 'e' || peekChar() == 'E') && 
+                (std::isdigit(peekChar(1)) || 
+                 ((peekChar(1) == '+' || peekChar(1) == '-') && std::isdigit(peekChar(2))))) {
                 is_float = true;
-                value += advance(); // e/E
-                if (peek() == '+' || peek() == '-') {
-                    value += advance();
+                advance(); // e/E
+                if (peekChar() == '+' || peekChar() == '-') {
+                    advance();
                 }
-                while (std::isdigit(peek())) {
-                    value += advance();
+                while (std::isdigit(peekChar())) {
+                    advance();
                 }
             }
         }
         
-        return Token(is_float ? TokenType::FLOAT : TokenType::INTEGER, value, start_line, start_col);
+        return Token(is_float ? TokenType::FLOAT : TokenType::INTEGER, input_.substr(start, pos_ - start), start_line, start_col);
     }
     
     Token readString() {
         size_t start_line = line_;
         size_t start_col = column_;
-        std::string value;
+        bool escaped = false;
         
         advance(); // Skip opening quote
+        size_t start = pos_;
         
-        while (peek() != '"' && peek() != '\0') {
-            if (peek() == '\\' && peek(1) == '"') {
-                advance(); // Skip backslash
-                value += advance(); // Add quote
-            } else if (peek() == '\\' && peek(1) == '\\') {
+        while (peekChar() != '"' && peekChar() != '\0') {
+            if (peekChar() == '\\' && (peekChar(1) == '"' || peekChar(1) == '\\')) {
+                escaped = true;
                 advance(); // Skip backslash
-                value += advance(); // Add backslash
-            } else {
-                value += advance();
             }
+            advance();
         }
+        std::string_view value = input_.substr(start, pos_ - start);
         
-        if (peek() == '"') {
+        if (peekChar() == '"') {
             advance(); // Skip closing quote
         }
         
-        return Token(TokenType::STRING, value, start_line, start_col);
+        return Token(TokenType::STRING, value, start_line, start_col, escaped);
     }
     
     Token readIdentifier() {
         size_t start_line = line_;
         size_t start_col = column_;
-        std::string value;
+        size_t start = pos_;
         
         // First character must be letter or underscore
-        if (std::isalpha(peek()) || peek() == '_') {
-            value += advance();
+        if (std::isalpha(peekChar()) || peekChar() == '_') {
+            advance();
         }
         
         // Subsequent characters can be letters, digits, or underscore
-        while (std::isalnum(peek()) || peek() == '_') {
-            value += advance();
+        while (std::isalnum(peekChar()) || peekChar() == '_') {
+            advance();
         }
+        std::string_view value = input_.substr(start, pos_ - start);
         
         // Check for keywords
         TokenType type = TokenType::IDENTIFIER;
@@ -309,13 +427,20 @@ private:
         return Token(type, value, start_line, start_col);
     }
     
-public:
-    DBCLexer(const std::string& input) 
-        : input_(input), pos_(0), line_(1), column_(1) {}
+    // Advances past the closing quote of a string whose opening quote was consumed
+    void skipStringBody() {
+        while (pos_ < input_.size()) {
+            char ch = advance();
+            if (ch == '\\' && (peekChar() == '"' || peekChar() == '\\')) {
+                advance();
+            } else if (ch == '"') {
+                return;
+            }
+        }
+    }
     
-    std::vector<Token> tokenize() {
-        std::vector<Token> tokens;
-        
+    // Scans one token from the input, END_OF_FILE once the input is exhausted
+    Token scan() {
         while (pos_ < input_.size()) {
             skipWhitespace();
             skipComment();
@@ -325,57 +450,140 @@ public:
             
             size_t start_line = line_;
             size_t start_col = column_;
-            char ch = peek();
+            char ch = peekChar();
             
             if (ch == '\0') {
                 break;
             } else if (ch == ':') {
                 advance();
-                tokens.emplace_back(TokenType::COLON, ":", start_line, start_col);
+                return Token(TokenType::COLON, ":", start_line, start_col);
             } else if (ch == ';') {
                 advance();
-                tokens.emplace_back(TokenType::SEMICOLON, ";", start_line, start_col);
+                return Token(TokenType::SEMICOLON, ";", start_line, start_col);
             } else if (ch == ',') {
                 advance();
-                tokens.emplace_back(TokenType::COMMA, ",", start_line, start_col);
+                return Token(TokenType::COMMA, ",", start_line, start_col);
             } else if (ch == '@') {
                 advance();
-                tokens.emplace_back(TokenType::AT, "@", start_line, start_col);
+                return Token(TokenType::AT, "@", start_line, start_col);
             } else if (ch == '+') {
                 advance();
-                tokens.emplace_back(TokenType::PLUS, "+", start_line, start_col);
-            } else if (ch == '-' && !std::isdigit(peek(1))) {
+                return Token(TokenType::PLUS, "+", start_line, start_col);
+            } else if (ch == '-' && !std::isdigit(peekChar(1))) {
                 advance();
-                tokens.emplace_back(TokenType::MINUS, "-", start_line, start_col);
+                return Token(TokenType::MINUS, "-", start_line, start_col);
             } else if (ch == '|') {
                 advance();
-                tokens.emplace_back(TokenType::PIPE, "|", start_line, start_col);
+                return Token(TokenType::PIPE, "|", start_line, start_col);
             } else if (ch == '(') {
                 advance();
-                tokens.emplace_back(TokenType::LPAREN, "(", start_line, start_col);
+                return Token(TokenType::LPAREN, "(", start_line, start_col);
             } else if (ch == ')') {
                 advance();
-                tokens.emplace_back(TokenType::RPAREN, ")", start_line, start_col);
+                return Token(TokenType::RPAREN, ")", start_line, start_col);
             } else if (ch == '[') {
                 advance();
-                tokens.emplace_back(TokenType::LBRACKET, "[", start_line, start_col);
+                return Token(TokenType::LBRACKET, "[", start_line, start_col);
             } else if (ch == ']') {
                 advance();
-                tokens.emplace_back(TokenType::RBRACKET, "]", start_line, start_col);
+                return Token(TokenType::RBRACKET, "]", start_line, start_col);
             } else if (ch == '"') {
-                tokens.push_back(readString());
-            } else if (std::isdigit(ch) || (ch == '-' && std::isdigit(peek(1)))) {
-                tokens.push_back(readNumber());
+                return readString();
+            } else if (std::isdigit(ch) || (ch == '-' && std::isdigit(peekChar(1)))) {
+                return readNumber();
             } else if (std::isalpha(ch) || ch == '_') {
-                tokens.push_back(readIdentifier());
+                return readIdentifier();
             } else {
                 // Unknown character
-                std::string unknown(1, advance());
-                tokens.emplace_back(TokenType::UNKNOWN, unknown, start_line, start_col);
+                advance();
+                return Token(TokenType::UNKNOWN, input_.substr(pos_ - 1, 1), start_line, start_col);
             }
         }
         
-        tokens.emplace_back(TokenType::END_OF_FILE, "", line_, column_);
+        return Token(TokenType::END_OF_FILE, "", line_, column_);
+    }
+    
+public:
+    DBCLexer(std::string_view input) 
+        : input_(input), pos_(0), line_(1), column_(1), ring_head_(0), ring_count_(0) {}
+    
+    // The k-th token ahead without consuming it, k < max_lookahead.
+    // The reference stays valid until the token is consumed by next().
+    const Token& peek(size_t k = 0) {
+        // peeking further would overwrite the oldest buffered token
+        assert(k < max_lookahead);
+        while (ring_count_ <= k) {
+            ring_[(ring_head_ + ring_count_) % max_lookahead] = scan();
+            ring_count_++;
+        }
+        return ring_[(ring_head_ + k) % max_lookahead];
+    }
+    
+    // Consumes the next token, END_OF_FILE is returned repeatedly at the end of the input
+    Token next() {
+        if (ring_count_ == 0) {
+            return scan();
+        }
+        Token token = ring_[ring_head_];
+        ring_head_ = (ring_head_ + 1) % max_lookahead;
+        ring_count_--;
+        return token;
+    }
+    
+    // Discards everything up to and including the next ';' without producing tokens.
+    // Quoted strings and comments are stepped over as a whole like scan() does, so neither
+    // a ';' inside a CM_ text nor a '"' inside a // comment is mistaken for syntax.
+    void skipStatement() {
+        while (ring_count_ != 0) {
+            TokenType type = ring_[ring_head_].type;
+            ring_head_ = (ring_head_ + 1) % max_lookahead;
+            ring_count_--;
+            if (type == TokenType::SEMICOLON) {
+                return;
+            }
+        }
+        while (pos_ < input_.size()) {
+            if (atComment()) {
+                skipComment();
+                continue;
+            }
+            char ch = advance();
+            if (ch == ';') {
+                return;
+            }
+            if (ch == '"') {
+                skipStringBody();
+            }
+        }
+    }
+    
+    // Discards the rest of the line the buffered lookahead is on, for statements
+    // like SG_ which end at the line break. The lookahead must not reach past that line.
+    void skipLine() {
+        ring_head_ = 0;
+        ring_count_ = 0;
+        while (pos_ < input_.size()) {
+            if (atComment()) {
+                // a // comment stops before the line break, which ends the loop below
+                skipComment();
+                continue;
+            }
+            char ch = advance();
+            if (ch == '\n') {
+                return;
+            }
+            if (ch == '"') {
+                skipStringBody();
+            }
+        }
+    }
+    
+    // Materializes all remaining tokens including the trailing END_OF_FILE
+    std::vector<Token> tokenize() {
+        std::vector<Token> tokens;
+        do {
+            tokens.push_back(next());
+        } while (tokens.back().type != TokenType::END_OF_FILE);
         return tokens;
     }
 };
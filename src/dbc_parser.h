@@ -2,38 +2,51 @@
 
 #include "dbc_lexer.h"
 #include "dbcast.h"
-#include "dbc_parser_result.h"
+#include <dbcppp-tiny/dbc_parser_result.h>
 #include "log.h"
 #include <memory>
 #include <algorithm>
+#include <functional>
+#include <unordered_set>
 
 namespace dbcppp {
 
 class DBCParser {
+public:
+    // Same shape as INetwork::MessageFilter/SignalFilter
+    using MessageFilter = std::function<bool(uint32_t message_id, const std::string& message_name)>;
+    using SignalFilter = std::function<bool(const std::string& signal_name, uint32_t message_id)>;
+
 private:
-    std::vector<Token> tokens_;
-    size_t pos_;
+    // tokens are pulled from the lexer as the grammar consumes them, so only
+    // the lookahead window and the last consumed token are alive at any time
+    DBCLexer lexer_{std::string_view()};
+    Token previous_;
+
+    // filters pushed down from the loader, rejected messages and signals are
+    // skipped in the lexer together with the statements referring to them
+    MessageFilter message_filter_;
+    SignalFilter signal_filter_;
+    std::unordered_set<uint64_t> rejected_messages_;
+    uint32_t skipped_messages_ = 0;
+    uint32_t skipped_signals_ = 0;
+    uint32_t skipped_statements_ = 0;
     
-    const Token& current() const {
-        if (pos_ >= tokens_.size()) {
-            static Token eof(TokenType::END_OF_FILE, "", 0, 0);
-            return eof;
-        }
-        return tokens_[pos_];
+    const Token& current() {
+        return lexer_.peek();
     }
     
-    const Token& peek(size_t offset = 1) const {
-        if (pos_ + offset >= tokens_.size()) {
-            static Token eof(TokenType::END_OF_FILE, "", 0, 0);
-            return eof;
-        }
-        return tokens_[pos_ + offset];
+    const Token& peek(size_t offset = 1) {
+        return lexer_.peek(offset);
+    }
+    
+    // the token consumed by the last advance()/match()/expect()
+    const Token& previous() const {
+        return previous_;
     }
     
     void advance() {
-        if (pos_ < tokens_.size()) {
-            pos_++;
-        }
+        previous_ = lexer_.next();
     }
     
     bool match(TokenType type) {
@@ -85,6 +98,69 @@ private:
         }
     }
     
+    bool filtering() const {
+        return message_filter_ || signal_filter_;
+    }
+    
+    bool isRejectedMessage(const Token& id) const {
+        return id.type == TokenType::INTEGER &&
+            rejected_messages_.count(parseUnsigned(id.value)) != 0;
+    }
+    
+    bool isRejectedSignal(const Token& id, const Token& name) const {
+        if (id.type != TokenType::INTEGER || name.type != TokenType::IDENTIFIER) {
+            return false;
+        }
+        uint64_t message_id = parseUnsigned(id.value);
+        if (rejected_messages_.count(message_id) != 0) {
+            return true;
+        }
+        return signal_filter_ && !signal_filter_(name.text(), uint32_t(message_id));
+    }
+    
+    // Decides from the lookahead whether the statement at current() only
+    // describes a message or signal which was filtered out
+    bool isFilteredStatement() {
+        switch (current().type) {
+            case TokenType::CM_:
+                if (peek(1).type == TokenType::BO_) return isRejectedMessage(peek(2));
+                if (peek(1).type == TokenType::SG_) return isRejectedSignal(peek(2), peek(3));
+                return false;
+            case TokenType::BA_:
+                if (peek(2).type == TokenType::BO_) return isRejectedMessage(peek(3));
+                if (peek(2).type == TokenType::SG_) return isRejectedSignal(peek(3), peek(4));
+                return false;
+            case TokenType::VAL_:
+            case TokenType::SG_MUL_VAL_:
+            case TokenType::SIG_VALTYPE_:
+                return isRejectedSignal(peek(1), peek(2));
+            case TokenType::BO_TX_BU_:
+            case TokenType::SIG_GROUP_:
+                return isRejectedMessage(peek(1));
+            default:
+                return false;
+        }
+    }
+    
+    // Skips a rejected BO_ block with all of its SG_ lines, returns false if the message is kept
+    bool skipFilteredMessage() {
+        if (!message_filter_ || peek(1).type != TokenType::INTEGER || peek(2).type != TokenType::IDENTIFIER) {
+            return false;
+        }
+        uint64_t id = parseUnsigned(peek(1).value);
+        if (message_filter_(uint32_t(id), peek(2).text())) {
+            return false;
+        }
+        rejected_messages_.insert(id);
+        skipped_messages_++;
+        lexer_.skipLine();
+        while (current().type == TokenType::SG_) {
+            lexer_.skipLine();
+            skipped_signals_++;
+        }
+        return true;
+    }
+    
     // Parse functions for each DBC element
     Result<AST::Version> parseVersion() {
         AST::Version version;
@@ -99,7 +175,7 @@ private:
                 "Expected string for version", current().line, current().column);
         }
         
-        version.version = current().value;
+        version.version = current().text();
         advance();
         
         return Ok(std::move(version));
@@ -128,7 +204,7 @@ private:
                 current().type == TokenType::BA_ ||
                 current().type == TokenType::VAL_ ||
                 current().type == TokenType::BA_DEF_DEF_) {
-                symbols.push_back(current().value);
+                symbols.push_back(current().text());
             }
             advance();
         }
@@ -151,7 +227,7 @@ private:
         }
         
         AST::BitTiming bt;
-        bt.baudrate = std::stoull(current().value);
+        bt.baudrate = parseUnsigned(current().value);
         advance();
         
         if (auto res = expect(TokenType::COLON); res.isError()) {
@@ -162,7 +238,7 @@ private:
             return Err<std::optional<AST::BitTiming>>(ParseErrorCode::UnexpectedToken,
                 "Expected integer for BTR1", current().line, current().column);
         }
-        bt.btr1 = std::stoull(current().value);
+        bt.btr1 = parseUnsigned(current().value);
         advance();
         
         if (auto res = expect(TokenType::COMMA); res.isError()) {
@@ -173,7 +249,7 @@ private:
             return Err<std::optional<AST::BitTiming>>(ParseErrorCode::UnexpectedToken,
                 "Expected integer for BTR2", current().line, current().column);
         }
-        bt.btr2 = std::stoull(current().value);
+        bt.btr2 = parseUnsigned(current().value);
         advance();
         
         return Ok(std::optional<AST::BitTiming>(std::move(bt)));
@@ -185,11 +261,13 @@ private:
         if (auto res = expect(TokenType::BU_); res.isError()) {
             return Err<std::vector<AST::NodeDef>>(res.error());
         }
+        // "BU_:" as written by every tool, the colon is optional
+        match(TokenType::COLON);
         
         while (current().type == TokenType::IDENTIFIER) {
             AST::NodeDef node;
             node.pos = {current().line, current().column};
-            node.name = current().value;
+            node.name = current().text();
             nodes.push_back(node);
             advance();
         }
@@ -210,7 +288,7 @@ private:
             return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
                 "Expected signal name", current().line, current().column);
         }
-        signal.name = current().value;
+        signal.name = current().text();
         advance();
         
         // Optional multiplexer indicator
@@ -220,17 +298,17 @@ private:
             advance();
         } else if (current().type == TokenType::MUX_m) {
             // Handle extended multiplexer syntax like m0M, m1, etc.
-            std::string mux_str = current().value;
+            std::string_view mux_str = current().value;
             if (mux_str.back() == 'M') {
                 // Extended multiplexer (e.g., m0M)
                 signal.mux_type = AST::MultiplexerType::MuxValue;
-                signal.mux_value = std::stoull(mux_str.substr(1, mux_str.length() - 2));
+                signal.mux_value = parseUnsigned(mux_str.substr(1, mux_str.length() - 2));
                 // Note: This signal is also a multiplexer switch, but our AST doesn't support this yet
                 // TODO: Add extended multiplexer support to AST
             } else {
                 signal.mux_type = AST::MultiplexerType::MuxValue;
                 // Extract the number from m<num>
-                signal.mux_value = std::stoull(mux_str.substr(1));
+                signal.mux_value = parseUnsigned(mux_str.substr(1));
             }
             advance();
         }
@@ -244,7 +322,7 @@ private:
             return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
                 "Expected integer for start bit", current().line, current().column);
         }
-        signal.start_bit = std::stoull(current().value);
+        signal.start_bit = parseUnsigned(current().value);
         advance();
         
         if (auto res = expect(TokenType::PIPE); res.isError()) {
@@ -256,7 +334,7 @@ private:
             return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
                 "Expected integer for signal size", current().line, current().column);
         }
-        signal.length = std::stoull(current().value);
+        signal.length = parseUnsigned(current().value);
         advance();
         
         if (auto res = expect(TokenType::AT); res.isError()) {
@@ -289,7 +367,7 @@ private:
         
         // Factor
         if (current().type == TokenType::FLOAT || current().type == TokenType::INTEGER) {
-            signal.factor = std::stod(current().value);
+            signal.factor = parseDouble(current().value);
             advance();
         } else {
             return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
@@ -302,7 +380,7 @@ private:
         
         // Offset
         if (current().type == TokenType::FLOAT || current().type == TokenType::INTEGER) {
-            signal.offset = std::stod(current().value);
+            signal.offset = parseDouble(current().value);
             advance();
         } else if (current().type == TokenType::MINUS) {
             advance();
@@ -310,7 +388,7 @@ private:
                 return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
                     "Expected number after minus sign", current().line, current().column);
             }
-            signal.offset = -std::stod(current().value);
+            signal.offset = -parseDouble(current().value);
             advance();
         } else {
             return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
@@ -327,7 +405,7 @@ private:
         
         // Minimum
         if (current().type == TokenType::FLOAT || current().type == TokenType::INTEGER) {
-            signal.minimum = std::stod(current().value);
+            signal.minimum = parseDouble(current().value);
             advance();
         } else if (current().type == TokenType::MINUS) {
             advance();
@@ -335,7 +413,7 @@ private:
                 return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
                     "Expected number after minus sign", current().line, current().column);
             }
-            signal.minimum = -std::stod(current().value);
+            signal.minimum = -parseDouble(current().value);
             advance();
         } else {
             return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
@@ -348,7 +426,7 @@ private:
         
         // Maximum
         if (current().type == TokenType::FLOAT || current().type == TokenType::INTEGER) {
-            signal.maximum = std::stod(current().value);
+            signal.maximum = parseDouble(current().value);
             advance();
         } else if (current().type == TokenType::PLUS) {
             advance();
@@ -356,7 +434,7 @@ private:
                 return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
                     "Expected number after plus sign", current().line, current().column);
             }
-            signal.maximum = std::stod(current().value);
+            signal.maximum = parseDouble(current().value);
             advance();
         } else if (current().type == TokenType::MINUS) {
             advance();
@@ -364,7 +442,7 @@ private:
                 return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
                     "Expected number after minus sign", current().line, current().column);
             }
-            signal.maximum = -std::stod(current().value);
+            signal.maximum = -parseDouble(current().value);
             advance();
         } else {
             return Err<AST::Signal>(ParseErrorCode::UnexpectedToken,
@@ -379,11 +457,11 @@ private:
         if (auto res = expect(TokenType::STRING); res.isError()) {
             return Err<AST::Signal>(res.error());
         }
-        signal.unit = tokens_[pos_ - 1].value;
+        signal.unit = previous().text();
         
         // Receivers
         while (current().type == TokenType::IDENTIFIER && current().value != "SG_") {
-            signal.receivers.push_back(current().value);
+            signal.receivers.push_back(current().text());
             advance();
             
             // Skip optional comma
@@ -408,7 +486,7 @@ private:
             return Err<AST::Message>(ParseErrorCode::UnexpectedToken,
                 "Expected message ID", current().line, current().column);
         }
-        message.id = std::stoull(current().value);
+        message.id = parseUnsigned(current().value);
         advance();
         
         // Message name
@@ -416,7 +494,7 @@ private:
             return Err<AST::Message>(ParseErrorCode::UnexpectedToken,
                 "Expected message name", current().line, current().column);
         }
-        message.name = current().value;
+        message.name = current().text();
         advance();
         
         if (auto res = expect(TokenType::COLON); res.isError()) {
@@ -428,17 +506,23 @@ private:
             return Err<AST::Message>(ParseErrorCode::UnexpectedToken,
                 "Expected message size (DLC)", current().line, current().column);
         }
-        message.size = std::stoull(current().value);
+        message.size = parseUnsigned(current().value);
         advance();
         
         // Transmitter
         if (current().type == TokenType::IDENTIFIER) {
-            message.transmitter = current().value;
+            message.transmitter = current().text();
             advance();
         }
         
         // Parse signals
         while (current().type == TokenType::SG_) {
+            if (signal_filter_ && peek(1).type == TokenType::IDENTIFIER &&
+                !signal_filter_(peek(1).text(), uint32_t(message.id))) {
+                lexer_.skipLine();
+                skipped_signals_++;
+                continue;
+            }
             auto signalResult = parseSignal();
             if (signalResult.isError()) {
                 return Err<AST::Message>(signalResult.error());
@@ -462,19 +546,19 @@ private:
             return Err<AST::ValueTable>(ParseErrorCode::UnexpectedToken,
                 "Expected value table name", current().line, current().column);
         }
-        vt.name = current().value;
+        vt.name = current().text();
         advance();
         
         // Parse value descriptions
         while (current().type == TokenType::INTEGER) {
             AST::ValueEncodingDescription desc;
-            desc.value = std::stoll(current().value);
+            desc.value = parseSigned(current().value);
             advance();
             
             if (auto res = expect(TokenType::STRING); res.isError()) {
                 return Err<AST::ValueTable>(res.error());
             }
-            desc.description = tokens_[pos_ - 1].value;
+            desc.description = previous().text();
             
             vt.descriptions.push_back(desc);
         }
@@ -503,7 +587,7 @@ private:
                 return Err<AST::Comment>(ParseErrorCode::UnexpectedToken,
                     "Expected message ID", current().line, current().column);
             }
-            comment.message_id = std::stoull(current().value);
+            comment.message_id = parseUnsigned(current().value);
             advance();
         } else if (current().type == TokenType::SG_) {
             advance();
@@ -512,13 +596,13 @@ private:
                 return Err<AST::Comment>(ParseErrorCode::UnexpectedToken,
                     "Expected message ID", current().line, current().column);
             }
-            comment.message_id = std::stoull(current().value);
+            comment.message_id = parseUnsigned(current().value);
             advance();
             if (current().type != TokenType::IDENTIFIER) {
                 return Err<AST::Comment>(ParseErrorCode::UnexpectedToken,
                     "Expected signal name", current().line, current().column);
             }
-            comment.signal_name = current().value;
+            comment.signal_name = current().text();
             advance();
         } else if (current().type == TokenType::BU_) {
             advance();
@@ -527,7 +611,7 @@ private:
                 return Err<AST::Comment>(ParseErrorCode::UnexpectedToken,
                     "Expected node name", current().line, current().column);
             }
-            comment.node_name = current().value;
+            comment.node_name = current().text();
             advance();
         } else {
             comment.type = AST::Comment::Type::Network;
@@ -536,7 +620,7 @@ private:
         if (auto res = expect(TokenType::STRING); res.isError()) {
             return Err<AST::Comment>(res.error());
         }
-        comment.text = tokens_[pos_ - 1].value;
+        comment.text = previous().text();
         
         if (auto res = expect(TokenType::SEMICOLON); res.isError()) {
             return Err<AST::Comment>(res.error());
@@ -557,21 +641,21 @@ private:
             return Err<AST::SignalMultiplexerValue>(ParseErrorCode::UnexpectedToken,
                 "Expected message ID", current().line, current().column);
         }
-        smv.message_id = std::stoull(current().value);
+        smv.message_id = parseUnsigned(current().value);
         advance();
         
         if (current().type != TokenType::IDENTIFIER) {
             return Err<AST::SignalMultiplexerValue>(ParseErrorCode::UnexpectedToken,
                 "Expected signal name", current().line, current().column);
         }
-        smv.signal_name = current().value;
+        smv.signal_name = current().text();
         advance();
         
         if (current().type != TokenType::IDENTIFIER) {
             return Err<AST::SignalMultiplexerValue>(ParseErrorCode::UnexpectedToken,
                 "Expected switch name", current().line, current().column);
         }
-        smv.switch_name = current().value;
+        smv.switch_name = current().text();
         advance();
         
         // Parse value ranges
@@ -580,7 +664,7 @@ private:
             
             // Handle single value or range
             if (current().type == TokenType::INTEGER) {
-                range.from = std::stoull(current().value);
+                range.from = parseUnsigned(current().value);
                 advance();
                 
                 if (current().type == TokenType::MINUS) {
@@ -589,7 +673,11 @@ private:
                         return Err<AST::SignalMultiplexerValue>(ParseErrorCode::UnexpectedToken,
                             "Expected integer after minus in range", current().line, current().column);
                     }
-                    range.to = std::stoull(current().value);
+                    range.to = parseUnsigned(current().value);
+                    advance();
+                } else if (current().type == TokenType::INTEGER && !current().value.empty() && current().value[0] == '-') {
+                    // the lexer takes "3-5" as the integers 3 and -5
+                    range.to = parseUnsigned(current().value.substr(1));
                     advance();
                 } else {
                     // Single value, not a range
@@ -644,20 +732,20 @@ private:
         if (auto res = expect(TokenType::STRING); res.isError()) {
             return Err<AST::AttributeDefinition>(res.error());
         }
-        def.name = tokens_[pos_ - 1].value;
+        def.name = previous().text();
         
         // Value type
         if (current().type == TokenType::IDENTIFIER || current().type == TokenType::STRING) {
-            def.value_type = current().value;
+            def.value_type = current().text();
             advance();
             
             // Handle numeric ranges
             if (def.value_type == "INT" || def.value_type == "HEX" || def.value_type == "FLOAT") {
                 if (current().type == TokenType::INTEGER || current().type == TokenType::FLOAT) {
-                    def.min_value = std::stod(current().value);
+                    def.min_value = parseDouble(current().value);
                     advance();
                     if (current().type == TokenType::INTEGER || current().type == TokenType::FLOAT) {
-                        def.max_value = std::stod(current().value);
+                        def.max_value = parseDouble(current().value);
                         advance();
                     } else {
                         return Err<AST::AttributeDefinition>(ParseErrorCode::UnexpectedToken,
@@ -668,7 +756,7 @@ private:
             // Handle enum values
             else if (def.value_type == "ENUM") {
                 while (current().type == TokenType::STRING) {
-                    def.enum_values.push_back(current().value);
+                    def.enum_values.push_back(current().text());
                     advance();
                     if (current().type == TokenType::COMMA) {
                         advance();
@@ -678,7 +766,7 @@ private:
             // Handle string default
             else if (def.value_type == "STRING") {
                 if (current().type == TokenType::STRING) {
-                    def.default_value = current().value;
+                    def.default_value = current().text();
                     advance();
                 }
             }
@@ -706,7 +794,7 @@ private:
         if (auto res = expect(TokenType::STRING); res.isError()) {
             return Err<AST::AttributeValue_t>(res.error());
         }
-        attr.attribute_name = tokens_[pos_ - 1].value;
+        attr.attribute_name = previous().text();
         
         // Determine attribute type
         if (current().type == TokenType::BU_) {
@@ -716,7 +804,7 @@ private:
                 return Err<AST::AttributeValue_t>(ParseErrorCode::UnexpectedToken,
                     "Expected node name", current().line, current().column);
             }
-            attr.node_name = current().value;
+            attr.node_name = current().text();
             advance();
         } else if (current().type == TokenType::BO_) {
             advance();
@@ -725,7 +813,7 @@ private:
                 return Err<AST::AttributeValue_t>(ParseErrorCode::UnexpectedToken,
                     "Expected message ID", current().line, current().column);
             }
-            attr.message_id = std::stoull(current().value);
+            attr.message_id = parseUnsigned(current().value);
             advance();
         } else if (current().type == TokenType::SG_) {
             advance();
@@ -734,13 +822,13 @@ private:
                 return Err<AST::AttributeValue_t>(ParseErrorCode::UnexpectedToken,
                     "Expected message ID", current().line, current().column);
             }
-            attr.message_id = std::stoull(current().value);
+            attr.message_id = parseUnsigned(current().value);
             advance();
             if (current().type != TokenType::IDENTIFIER) {
                 return Err<AST::AttributeValue_t>(ParseErrorCode::UnexpectedToken,
                     "Expected signal name", current().line, current().column);
             }
-            attr.signal_name = current().value;
+            attr.signal_name = current().text();
             advance();
         } else {
             attr.type = AST::AttributeValue_t::Type::Network;
@@ -748,13 +836,13 @@ private:
         
         // Attribute value
         if (current().type == TokenType::INTEGER) {
-            attr.value = std::stoll(current().value);
+            attr.value = parseSigned(current().value);
             advance();
         } else if (current().type == TokenType::FLOAT) {
-            attr.value = std::stod(current().value);
+            attr.value = parseDouble(current().value);
             advance();
         } else if (current().type == TokenType::STRING) {
-            attr.value = current().value;
+            attr.value = current().text();
             advance();
         } else {
             return Err<AST::AttributeValue_t>(ParseErrorCode::UnexpectedToken,
@@ -781,7 +869,7 @@ private:
             return Err<AST::MessageTransmitter>(ParseErrorCode::UnexpectedToken,
                 "Expected message ID", current().line, current().column);
         }
-        mt.message_id = std::stoull(current().value);
+        mt.message_id = parseUnsigned(current().value);
         advance();
         
         if (auto res = expect(TokenType::COLON); res.isError()) {
@@ -790,7 +878,7 @@ private:
         
         // Transmitters
         while (current().type == TokenType::IDENTIFIER) {
-            mt.transmitters.push_back(current().value);
+            mt.transmitters.push_back(current().text());
             advance();
             if (current().type == TokenType::COMMA) {
                 advance();
@@ -815,14 +903,14 @@ private:
         // Signal value description only
         if (current().type == TokenType::INTEGER) {
             vd.type = AST::ValueDescription::Type::Signal;
-            vd.message_id = std::stoull(current().value);
+            vd.message_id = parseUnsigned(current().value);
             advance();
             
             if (current().type != TokenType::IDENTIFIER) {
                 return Err<AST::ValueDescription>(ParseErrorCode::UnexpectedToken,
                     "Expected signal name", current().line, current().column);
             }
-            vd.object_name = current().value;
+            vd.object_name = current().text();
             advance();
         } else {
             return Err<AST::ValueDescription>(ParseErrorCode::UnexpectedToken,
@@ -832,13 +920,13 @@ private:
         // Parse value descriptions
         while (current().type == TokenType::INTEGER) {
             AST::ValueEncodingDescription ved;
-            ved.value = std::stoll(current().value);
+            ved.value = parseSigned(current().value);
             advance();
             
             if (auto res = expect(TokenType::STRING); res.isError()) {
                 return Err<AST::ValueDescription>(res.error());
             }
-            ved.description = tokens_[pos_ - 1].value;
+            ved.description = previous().text();
             
             vd.descriptions.push_back(ved);
         }
@@ -861,17 +949,17 @@ private:
         if (auto res = expect(TokenType::STRING); res.isError()) {
             return Err<AST::AttributeDefault>(res.error());
         }
-        def.name = tokens_[pos_ - 1].value;
+        def.name = previous().text();
         
         // Parse attribute value
         if (current().type == TokenType::INTEGER) {
-            def.value = std::stoll(current().value);
+            def.value = parseSigned(current().value);
             advance();
         } else if (current().type == TokenType::FLOAT) {
-            def.value = std::stod(current().value);
+            def.value = parseDouble(current().value);
             advance();
         } else if (current().type == TokenType::STRING) {
-            def.value = current().value;
+            def.value = current().text();
             advance();
         } else {
             return Err<AST::AttributeDefault>(ParseErrorCode::UnexpectedToken,
@@ -897,21 +985,21 @@ private:
             return Err<AST::SignalGroup>(ParseErrorCode::UnexpectedToken,
                 "Expected message ID", current().line, current().column);
         }
-        sg.message_id = std::stoull(current().value);
+        sg.message_id = parseUnsigned(current().value);
         advance();
         
         if (current().type != TokenType::IDENTIFIER) {
             return Err<AST::SignalGroup>(ParseErrorCode::UnexpectedToken,
                 "Expected group name", current().line, current().column);
         }
-        sg.group_name = current().value;
+        sg.group_name = current().text();
         advance();
         
         if (current().type != TokenType::INTEGER) {
             return Err<AST::SignalGroup>(ParseErrorCode::UnexpectedToken,
                 "Expected repetitions count", current().line, current().column);
         }
-        sg.repetitions = std::stoull(current().value);
+        sg.repetitions = parseUnsigned(current().value);
         advance();
         
         if (auto res = expect(TokenType::COLON); res.isError()) {
@@ -920,7 +1008,7 @@ private:
         
         // Parse signal names
         while (current().type == TokenType::IDENTIFIER) {
-            sg.signal_names.push_back(current().value);
+            sg.signal_names.push_back(current().text());
             advance();
         }
         
@@ -943,14 +1031,14 @@ private:
             return Err<AST::SignalExtendedValueType>(ParseErrorCode::UnexpectedToken,
                 "Expected message ID", current().line, current().column);
         }
-        sevt.message_id = std::stoull(current().value);
+        sevt.message_id = parseUnsigned(current().value);
         advance();
         
         if (current().type != TokenType::IDENTIFIER) {
             return Err<AST::SignalExtendedValueType>(ParseErrorCode::UnexpectedToken,
                 "Expected signal name", current().line, current().column);
         }
-        sevt.signal_name = current().value;
+        sevt.signal_name = current().text();
         advance();
         
         if (auto res = expect(TokenType::COLON); res.isError()) {
@@ -961,7 +1049,7 @@ private:
             return Err<AST::SignalExtendedValueType>(ParseErrorCode::UnexpectedToken,
                 "Expected value type", current().line, current().column);
         }
-        sevt.value_type = std::stoull(current().value);
+        sevt.value_type = parseUnsigned(current().value);
         advance();
         
         if (auto res = expect(TokenType::SEMICOLON); res.isError()) {
@@ -983,7 +1071,7 @@ private:
             return Err<AST::SignalType>(ParseErrorCode::UnexpectedToken,
                 "Expected signal type name", current().line, current().column);
         }
-        st.name = current().value;
+        st.name = current().text();
         advance();
         
         if (auto res = expect(TokenType::COLON); res.isError()) {
@@ -994,7 +1082,7 @@ private:
             return Err<AST::SignalType>(ParseErrorCode::UnexpectedToken,
                 "Expected signal size", current().line, current().column);
         }
-        st.size = std::stoull(current().value);
+        st.size = parseUnsigned(current().value);
         advance();
         
         if (auto res = expect(TokenType::AT); res.isError()) {
@@ -1028,7 +1116,7 @@ private:
             return Err<AST::SignalType>(ParseErrorCode::UnexpectedToken,
                 "Expected factor value", current().line, current().column);
         }
-        st.factor = std::stod(current().value);
+        st.factor = parseDouble(current().value);
         advance();
         
         if (auto res = expect(TokenType::COMMA); res.isError()) {
@@ -1039,7 +1127,7 @@ private:
             return Err<AST::SignalType>(ParseErrorCode::UnexpectedToken,
                 "Expected offset value", current().line, current().column);
         }
-        st.offset = std::stod(current().value);
+        st.offset = parseDouble(current().value);
         advance();
         
         if (auto res = expect(TokenType::RPAREN); res.isError()) {
@@ -1054,7 +1142,7 @@ private:
             return Err<AST::SignalType>(ParseErrorCode::UnexpectedToken,
                 "Expected minimum value", current().line, current().column);
         }
-        st.minimum = std::stod(current().value);
+        st.minimum = parseDouble(current().value);
         advance();
         
         if (auto res = expect(TokenType::PIPE); res.isError()) {
@@ -1065,7 +1153,7 @@ private:
             return Err<AST::SignalType>(ParseErrorCode::UnexpectedToken,
                 "Expected maximum value", current().line, current().column);
         }
-        st.maximum = std::stod(current().value);
+        st.maximum = parseDouble(current().value);
         advance();
         
         if (auto res = expect(TokenType::RBRACKET); res.isError()) {
@@ -1075,13 +1163,13 @@ private:
         if (auto res = expect(TokenType::STRING); res.isError()) {
             return Err<AST::SignalType>(res.error());
         }
-        st.unit = tokens_[pos_ - 1].value;
+        st.unit = previous().text();
         
         if (current().type != TokenType::FLOAT && current().type != TokenType::INTEGER) {
             return Err<AST::SignalType>(ParseErrorCode::UnexpectedToken,
                 "Expected default value", current().line, current().column);
         }
-        st.default_value = std::stod(current().value);
+        st.default_value = parseDouble(current().value);
         advance();
         
         if (auto res = expect(TokenType::COMMA); res.isError()) {
@@ -1092,7 +1180,7 @@ private:
             return Err<AST::SignalType>(ParseErrorCode::UnexpectedToken,
                 "Expected value table name", current().line, current().column);
         }
-        st.value_table = current().value;
+        st.value_table = current().text();
         advance();
         
         if (auto res = expect(TokenType::SEMICOLON); res.isError()) {
@@ -1103,11 +1191,19 @@ private:
     }
     
 public:
-    Result<std::unique_ptr<AST::Network>> parse(const std::string& input) {
-        // Tokenize
-        DBCLexer lexer(input);
-        tokens_ = lexer.tokenize();
-        pos_ = 0;
+    // Filters applied by the following parse() calls, empty functions keep everything
+    void setFilters(MessageFilter message_filter, SignalFilter signal_filter) {
+        message_filter_ = std::move(message_filter);
+        signal_filter_ = std::move(signal_filter);
+    }
+    
+    Result<std::unique_ptr<AST::Network>> parse(std::string_view input) {
+        lexer_ = DBCLexer(input);
+        previous_ = Token();
+        rejected_messages_.clear();
+        skipped_messages_ = 0;
+        skipped_signals_ = 0;
+        skipped_statements_ = 0;
         
         auto network = std::make_unique<AST::Network>();
         
@@ -1143,6 +1239,16 @@ public:
         
         // Parse remaining elements
         while (current().type != TokenType::END_OF_FILE) {
+            if (filtering()) {
+                if (current().type == TokenType::BO_ && skipFilteredMessage()) {
+                    continue;
+                }
+                if (isFilteredStatement()) {
+                    lexer_.skipStatement();
+                    skipped_statements_++;
+                    continue;
+                }
+            }
             if (current().type == TokenType::VAL_TABLE_) {
                 auto result = parseValueTable();
                 if (result.isError()) {
@@ -1227,6 +1333,11 @@ public:
             }
         }
         
+        if (skipped_messages_ > 0 || skipped_signals_ > 0) {
+            LOG_INFO("Filter skipped %u messages, %u signals and %u related statements while parsing",
+                     skipped_messages_, skipped_signals_, skipped_statements_);
+        }
+        
         return Ok(std::move(network));
     }
 };
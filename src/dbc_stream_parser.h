@@ -2,11 +2,12 @@
 
 #include "file_reader.h"
 #include "dbcast.h"
-#include "dbc_parser_result.h"
+#include <dbcppp-tiny/dbc_parser_result.h>
 #include "dbc_lexer.h"
 #include <memory>
 #include <string>
 #include <vector>
+#include <string_view>
 #include <optional>
 #include <cctype>
 
@@ -115,15 +116,15 @@ private:
     AST::Message* current_message_;  // Track current message for signals
 
     // Remove quotes from string
-    std::string removeQuotes(const std::string& str) {
+    std::string removeQuotes(std::string_view str) {
         if (str.size() >= 2 && str.front() == '"' && str.back() == '"') {
-            return str.substr(1, str.size() - 2);
+            return std::string(str.substr(1, str.size() - 2));
         }
-        return str;
+        return std::string(str);
     }
 
     // Check if string is numeric
-    bool isNumeric(const std::string& str) {
+    bool isNumeric(std::string_view str) {
         if (str.empty()) return false;
         size_t start = 0;
         if (str[0] == '-' || str[0] == '+') start = 1;
@@ -188,7 +189,7 @@ private:
         if (tokens.empty()) return Ok();
 
         // Route to appropriate parser based on first token
-        const std::string& keyword = tokens[0].value;
+        std::string_view keyword = tokens[0].value;
 
         if (keyword == "VERSION") {
             return parseVersion(tokens, network);
@@ -227,7 +228,7 @@ private:
         if (tokens.size() < 2) {
             return Err<void>(ParseErrorCode::UnexpectedToken, "Invalid VERSION statement", 0, 0);
         }
-        network->version.version = tokens[1].value;
+        network->version.version = tokens[1].text();
         // Remove quotes if present
         if (network->version.version.size() >= 2 &&
             network->version.version.front() == '"' &&
@@ -259,7 +260,7 @@ private:
                 tokens[i].type == TokenType::FILTER ||
                 tokens[i].type == TokenType::BO_TX_BU_ ||
                 tokens[i].type == TokenType::SIG_GROUP_) {
-                network->new_symbols.push_back(tokens[i].value);
+                network->new_symbols.push_back(tokens[i].text());
             }
             i++;
         }
@@ -288,7 +289,7 @@ private:
 
         // Try to parse baudrate if present and numeric
         if (i < tokens.size() && isNumeric(tokens[i].value)) {
-            bt.baudrate = std::stoull(tokens[i].value);
+            bt.baudrate = parseUnsigned(tokens[i].value);
             i++;
         }
 
@@ -296,7 +297,7 @@ private:
 
         // Try to parse BTR1 if present and numeric
         if (i < tokens.size() && isNumeric(tokens[i].value)) {
-            bt.btr1 = std::stoull(tokens[i].value);
+            bt.btr1 = parseUnsigned(tokens[i].value);
             i++;
         }
 
@@ -304,7 +305,7 @@ private:
 
         // Try to parse BTR2 if present and numeric
         if (i < tokens.size() && isNumeric(tokens[i].value)) {
-            bt.btr2 = std::stoull(tokens[i].value);
+            bt.btr2 = parseUnsigned(tokens[i].value);
         }
 
         network->bit_timing = bt;
@@ -315,8 +316,11 @@ private:
     Result<void> parseNodes(const std::vector<Token>& tokens, AST::Network* network) {
         // BU_ node1 node2 ...
         for (size_t i = 1; i < tokens.size(); i++) {
+            if (tokens[i].type == TokenType::COLON) {
+                continue;
+            }
             AST::NodeDef node;
-            node.name = tokens[i].value;
+            node.name = tokens[i].text();
             network->nodes.push_back(std::move(node));
         }
         return Result<void>();
@@ -331,16 +335,13 @@ private:
 
         AST::Message message;
         // Parse message ID (can be extended format like 0x80000001)
-        try {
-            if (tokens[1].value.find("0x") == 0 || tokens[1].value.find("0X") == 0) {
-                message.id = std::stoull(tokens[1].value, nullptr, 16);
-            } else {
-                message.id = std::stoull(tokens[1].value);
-            }
-        } catch (...) {
+        bool hex = tokens[1].value.find("0x") == 0 || tokens[1].value.find("0X") == 0;
+        auto id = tryParseUnsigned(tokens[1].value, hex ? 16 : 10);
+        if (!id) {
             return Err<void>(ParseErrorCode::InvalidMessageFormat, "Invalid message ID", 0, 0);
         }
-        message.name = tokens[2].value;
+        message.id = *id;
+        message.name = tokens[2].text();
 
         size_t i = 3;
         if (tokens[i].value == ":") i++;
@@ -348,15 +349,15 @@ private:
         if (i >= tokens.size()) {
             return Err<void>(ParseErrorCode::InvalidMessageFormat, "Missing message size", 0, 0);
         }
-        try {
-            message.size = std::stoull(tokens[i].value);
-        } catch (...) {
+        auto size = tryParseUnsigned(tokens[i].value);
+        if (!size) {
             return Err<void>(ParseErrorCode::InvalidMessageFormat, "Invalid message size", 0, 0);
         }
+        message.size = *size;
         i++;
 
         if (i < tokens.size()) {
-            message.transmitter = tokens[i].value;
+            message.transmitter = tokens[i].text();
         }
 
         network->messages.push_back(std::move(message));
@@ -384,7 +385,7 @@ private:
         size_t i = 1;
         if (i >= tokens.size()) return Err<void>(ParseErrorCode::InvalidSignalFormat, "Invalid signal", 0, 0);
 
-        signal.name = tokens[i].value;
+        signal.name = tokens[i].text();
         i++;
 
         // Check for multiplexer indicator (M, m0, m1, etc.)
@@ -394,9 +395,9 @@ private:
                 i++;
             } else if (tokens[i].value[0] == 'm' && tokens[i].value.length() > 1) {
                 signal.mux_type = AST::MultiplexerType::MuxValue;
-                try {
-                    signal.mux_value = std::stoull(tokens[i].value.substr(1));
-                } catch (...) {}
+                if (auto mux_value = tryParseUnsigned(tokens[i].value.substr(1))) {
+                    signal.mux_value = *mux_value;
+                }
                 i++;
             }
         }
@@ -407,18 +408,18 @@ private:
 
         // Parse bit position and size
         if (i < tokens.size()) {
-            std::string bit_info = tokens[i].value;
+            std::string_view bit_info = tokens[i].value;
             size_t pipe_pos = bit_info.find('|');
             if (pipe_pos != std::string::npos) {
-                try {
-                    signal.start_bit = std::stoull(bit_info.substr(0, pipe_pos));
-                } catch (...) {}
+                if (auto start_bit = tryParseUnsigned(bit_info.substr(0, pipe_pos))) {
+                    signal.start_bit = *start_bit;
+                }
 
                 size_t at_pos = bit_info.find('@', pipe_pos);
                 if (at_pos != std::string::npos) {
-                    try {
-                        signal.length = std::stoull(bit_info.substr(pipe_pos + 1, at_pos - pipe_pos - 1));
-                    } catch (...) {}
+                    if (auto length = tryParseUnsigned(bit_info.substr(pipe_pos + 1, at_pos - pipe_pos - 1))) {
+                        signal.length = *length;
+                    }
                     signal.byte_order = bit_info[at_pos + 1];  // '0' = Motorola, '1' = Intel
 
                     // Find sign indicator
@@ -435,17 +436,17 @@ private:
         if (i < tokens.size() && tokens[i].value == "(") {
             i++;
             if (i < tokens.size()) {
-                try {
-                    signal.factor = std::stod(tokens[i].value);
-                } catch (...) {}
+                if (auto factor = tryParseDouble(tokens[i].value)) {
+                    signal.factor = *factor;
+                }
                 i++;
             }
             if (i < tokens.size() && tokens[i].value == ",") {
                 i++;
                 if (i < tokens.size()) {
-                    try {
-                        signal.offset = std::stod(tokens[i].value);
-                    } catch (...) {}
+                    if (auto offset = tryParseDouble(tokens[i].value)) {
+                        signal.offset = *offset;
+                    }
                     i++;
                 }
             }
@@ -456,17 +457,17 @@ private:
         if (i < tokens.size() && tokens[i].value == "[") {
             i++;
             if (i < tokens.size()) {
-                try {
-                    signal.minimum = std::stod(tokens[i].value);
-                } catch (...) {}
+                if (auto minimum = tryParseDouble(tokens[i].value)) {
+                    signal.minimum = *minimum;
+                }
                 i++;
             }
             if (i < tokens.size() && tokens[i].value == "|") {
                 i++;
                 if (i < tokens.size()) {
-                    try {
-                        signal.maximum = std::stod(tokens[i].value);
-                    } catch (...) {}
+                    if (auto maximum = tryParseDouble(tokens[i].value)) {
+                        signal.maximum = *maximum;
+                    }
                     i++;
                 }
             }
@@ -482,7 +483,7 @@ private:
         // Parse receivers (comma-separated list or Vector__XXX)
         while (i < tokens.size()) {
             if (tokens[i].value != ",") {
-                signal.receivers.push_back(tokens[i].value);
+                signal.receivers.push_back(tokens[i].text());
             }
             i++;
         }
@@ -538,7 +539,7 @@ private:
             return Err<void>(ParseErrorCode::UnexpectedToken, "Missing value type", 0, 0);
         }
 
-        std::string value_type = tokens[i].value;
+        std::string value_type = tokens[i].text();
         i++;
 
         attr_def.value_type = value_type;
@@ -546,21 +547,17 @@ private:
         if (value_type == "INT" || value_type == "HEX" || value_type == "FLOAT") {
             // Parse min value
             if (i < tokens.size() && tokens[i].value != ";") {
-                try {
-                    attr_def.min_value = std::stod(tokens[i].value);
+                if (auto min_value = tryParseDouble(tokens[i].value)) {
+                    attr_def.min_value = *min_value;
                     i++;
-                } catch (...) {
-                    // Not a number, skip
                 }
             }
 
             // Parse max value
             if (i < tokens.size() && tokens[i].value != ";") {
-                try {
-                    attr_def.max_value = std::stod(tokens[i].value);
+                if (auto max_value = tryParseDouble(tokens[i].value)) {
+                    attr_def.max_value = *max_value;
                     i++;
-                } catch (...) {
-                    // Not a number, skip
                 }
             }
         } else if (value_type == "STRING") {
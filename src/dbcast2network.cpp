@@ -4,11 +4,17 @@
 #include <unordered_map>
 #include <cassert>
 #include <algorithm>
+#include <cstdio>
 
 #include "dbcppp-tiny/network.h"
 #include "dbcast.h"
 #include "dbc_parser.h"
-#include "file_reader.h"
+#include "mapped_file.h"
+#include "network_snapshot.h"
+#include "content_hash.h"
+#include "network_impl.h"
+#include "arena.h"
+#include "string_pool.h"
 #include "log.h"
 
 using namespace dbcppp;
@@ -21,12 +27,22 @@ struct SignalCache
 {
     AttributeList Attributes;
     const AST::ValueDescription* ValueDescriptions = nullptr;
+    const AST::SignalExtendedValueType* ExtendedValueType = nullptr;
+    std::vector<const AST::SignalMultiplexerValue*> MultiplexerValues;
 };
 
 struct MessageCache
 {
     std::unordered_map<std::string, SignalCache> Signals;
     AttributeList Attributes;
+    const AST::MessageTransmitter* Transmitters = nullptr;
+    std::vector<const AST::SignalGroup*> SignalGroups;
+
+    const SignalCache* FindSignal(const std::string& name) const
+    {
+        auto iter = Signals.find(name);
+        return iter != Signals.end() ? &iter->second : nullptr;
+    }
 };
 
 struct NodeCache
@@ -34,12 +50,22 @@ struct NodeCache
     AttributeList Attributes;
 };
 
+// Index over the AST built once per conversion, so every message, signal and
+// value table resolves the statements referring to it with hash lookups
+// instead of scanning the statement lists.
 struct Cache
 {
 
     AttributeList NetworkAttributes;
     std::unordered_map<std::string, NodeCache> Nodes;
     std::unordered_map<uint64_t, MessageCache> Messages;
+    std::unordered_map<std::string, const AST::SignalType*> SignalTypes;
+
+    const MessageCache* FindMessage(uint64_t id) const
+    {
+        auto iter = Messages.find(id);
+        return iter != Messages.end() ? &iter->second : nullptr;
+    }
 };
 
 } // anon
@@ -54,17 +80,13 @@ static auto getNewSymbols(const AST::Network& net)
     return net.new_symbols;
 }
 
-static auto getSignalType(const AST::Network& net, const AST::ValueTable& vt)
+static auto getSignalType(const AST::ValueTable& vt, Cache const& cache)
 {
     std::optional<std::unique_ptr<ISignalType>> signal_type;
-    auto iter = std::find_if(net.signal_types.begin(), net.signal_types.end(),
-        [&](const auto& st)
-        {
-            return st.value_table == vt.name;
-        });
-    if (iter != net.signal_types.end())
+    auto iter = cache.SignalTypes.find(vt.name);
+    if (iter != cache.SignalTypes.end())
     {
-        auto& st = *iter;
+        auto& st = *iter->second;
         signal_type = ISignalType::Create(
               std::string(st.name)
             , st.size
@@ -81,12 +103,12 @@ static auto getSignalType(const AST::Network& net, const AST::ValueTable& vt)
     return signal_type;
 }
 
-static auto getValueTables(const AST::Network& net)
+static auto getValueTables(const AST::Network& net, Cache const& cache)
 {
     std::vector<std::unique_ptr<IValueTable>> value_tables;
     for (const auto& vt : net.value_tables)
     {
-        auto sig_type = getSignalType(net, vt);
+        auto sig_type = getSignalType(vt, cache);
         std::vector<std::unique_ptr<IValueEncodingDescription>> copy_ved;
         for (const auto& ved : vt.descriptions)
         {
@@ -163,24 +185,19 @@ static auto getNodes(const AST::Network& net, Cache const& cache)
     return nodes;
 }
 
-static auto getAttributeValues(const AST::Network& net, const AST::Message& m, const AST::Signal& s, Cache const& cache)
+static auto getAttributeValues(const SignalCache* sc)
 {
     std::vector<std::unique_ptr<IAttribute>> attribute_values;
-    auto const message_it = cache.Messages.find(m.id);
-
-    if (message_it != cache.Messages.end()) {
-        auto const signal_it = message_it->second.Signals.find(s.name);
 
-        if (signal_it != message_it->second.Signals.end()) {
-            attribute_values.reserve(signal_it->second.Attributes.size());
+    if (sc) {
+        attribute_values.reserve(sc->Attributes.size());
 
-            for (auto av : signal_it->second.Attributes)
-            {
-                if (av->type == AST::AttributeValue_t::Type::Signal) {
-                    auto value = convertAttributeValue(av->value);
-                    auto attribute = IAttribute::Create(std::string(av->attribute_name), IAttributeDefinition::EObjectType::Signal, std::move(value));
-                    attribute_values.emplace_back(std::move(attribute));
-                }
+        for (auto av : sc->Attributes)
+        {
+            if (av->type == AST::AttributeValue_t::Type::Signal) {
+                auto value = convertAttributeValue(av->value);
+                auto attribute = IAttribute::Create(std::string(av->attribute_name), IAttributeDefinition::EObjectType::Signal, std::move(value));
+                attribute_values.emplace_back(std::move(attribute));
             }
         }
     }
@@ -188,41 +205,29 @@ static auto getAttributeValues(const AST::Network& net, const AST::Message& m, c
     return attribute_values;
 }
 
-static auto getValueDescriptions(const AST::Network& net, const AST::Message& m, const AST::Signal& s, Cache const& cache)
+static auto getValueDescriptions(const SignalCache* sc)
 {
     std::vector<std::unique_ptr<IValueEncodingDescription>> value_descriptions;
-    auto const message_it = cache.Messages.find(m.id);
 
-    if (message_it != cache.Messages.end()) {
-        auto const signal_it = message_it->second.Signals.find(s.name);
+    if (sc && sc->ValueDescriptions) {
+        value_descriptions.reserve(sc->ValueDescriptions->descriptions.size());
 
-        if (signal_it != message_it->second.Signals.end()) {
-            if (signal_it->second.ValueDescriptions) {
-                value_descriptions.reserve(signal_it->second.ValueDescriptions->descriptions.size());
-
-                for (const auto& vd : signal_it->second.ValueDescriptions->descriptions)
-                {
-                    auto pvd = IValueEncodingDescription::Create(vd.value, std::string(vd.description));
-                    value_descriptions.push_back(std::move(pvd));
-                }
-            }
+        for (const auto& vd : sc->ValueDescriptions->descriptions)
+        {
+            auto pvd = IValueEncodingDescription::Create(vd.value, std::string(vd.description));
+            value_descriptions.push_back(std::move(pvd));
         }
     }
     return value_descriptions;
 }
 
 
-static auto getSignalExtendedValueType(const AST::Network& net, const AST::Message& m, const AST::Signal& s)
+static auto getSignalExtendedValueType(const SignalCache* sc)
 {
     ISignal::EExtendedValueType extended_value_type = ISignal::EExtendedValueType::Integer;
-    auto iter = std::find_if(net.signal_extended_value_types.begin(), net.signal_extended_value_types.end(),
-        [&](const AST::SignalExtendedValueType& sev)
-        {
-            return sev.message_id == m.id && sev.signal_name == s.name;
-        });
-    if (iter != net.signal_extended_value_types.end())
+    if (sc && sc->ExtendedValueType)
     {
-        switch (iter->value_type)
+        switch (sc->ExtendedValueType->value_type)
         {
         case 1: extended_value_type = ISignal::EExtendedValueType::Float; break;
         case 2: extended_value_type = ISignal::EExtendedValueType::Double; break;
@@ -231,29 +236,30 @@ static auto getSignalExtendedValueType(const AST::Network& net, const AST::Messa
     return extended_value_type;
 }
 
-static auto getSignalMultiplexerValues(const AST::Network& net, const std::string& s, const uint64_t m)
+static auto getSignalMultiplexerValues(const SignalCache* sc)
 {
     std::vector<std::unique_ptr<ISignalMultiplexerValue>> signal_multiplexer_values;
-    for (const auto& gsmv : net.signal_multiplexer_values)
+    if (!sc)
+    {
+        return signal_multiplexer_values;
+    }
+    for (const auto* gsmv : sc->MultiplexerValues)
     {
-        if (gsmv.signal_name == s && gsmv.message_id == m)
+        auto switch_name = gsmv->switch_name;
+        std::vector<ISignalMultiplexerValue::Range> value_ranges;
+        for (const auto& r : gsmv->value_ranges)
         {
-            auto switch_name = gsmv.switch_name;
-            std::vector<ISignalMultiplexerValue::Range> value_ranges;
-            for (const auto& r : gsmv.value_ranges)
-            {
-                value_ranges.push_back({static_cast<std::size_t>(r.from), static_cast<std::size_t>(r.to)});
-            }
-            auto signal_multiplexer_value = ISignalMultiplexerValue::Create(
-                  std::move(switch_name)
-                , std::move(value_ranges));
-            signal_multiplexer_values.push_back(std::move(signal_multiplexer_value));
+            value_ranges.push_back({static_cast<std::size_t>(r.from), static_cast<std::size_t>(r.to)});
         }
+        auto signal_multiplexer_value = ISignalMultiplexerValue::Create(
+              std::move(switch_name)
+            , std::move(value_ranges));
+        signal_multiplexer_values.push_back(std::move(signal_multiplexer_value));
     }
     return signal_multiplexer_values;
 }
 
-static auto getSignals(const AST::Network& net, const AST::Message& m, Cache const& cache)
+static auto getSignals(const AST::Message& m, const MessageCache* mc)
 {
     std::vector<std::unique_ptr<ISignal>> signals;
 
@@ -261,12 +267,13 @@ static auto getSignals(const AST::Network& net, const AST::Message& m, Cache con
 
     for (const AST::Signal& s : m.signals)
     {
+        const SignalCache* sc = mc ? mc->FindSignal(s.name) : nullptr;
         std::vector<std::string> receivers = s.receivers;
-        auto attribute_values = getAttributeValues(net, m, s, cache);
-        auto value_descriptions = getValueDescriptions(net, m, s, cache);
-        auto extended_value_type = getSignalExtendedValueType(net, m, s);
+        auto attribute_values = getAttributeValues(sc);
+        auto value_descriptions = getValueDescriptions(sc);
+        auto extended_value_type = getSignalExtendedValueType(sc);
         auto multiplexer_indicator = ISignal::EMultiplexer::NoMux;
-        auto signal_multiplexer_values = getSignalMultiplexerValues(net, s.name, m.id);
+        auto signal_multiplexer_values = getSignalMultiplexerValues(sc);
         uint64_t multiplexer_switch_value = 0;
         
         switch (s.mux_type)
@@ -331,31 +338,24 @@ static auto getSignals(const AST::Network& net, const AST::Message& m, Cache con
     return signals;
 }
 
-static auto getMessageTransmitters(const AST::Network& net, const AST::Message& m)
+static auto getMessageTransmitters(const MessageCache* mc)
 {
     std::vector<std::string> message_transmitters;
-    auto iter_mt = std::find_if(net.message_transmitters.begin(), net.message_transmitters.end(),
-        [&](const AST::MessageTransmitter& mt)
-        {
-            return mt.message_id == m.id;
-        });
-    if (iter_mt != net.message_transmitters.end())
+    if (mc && mc->Transmitters)
     {
-        message_transmitters = iter_mt->transmitters;
+        message_transmitters = mc->Transmitters->transmitters;
     }
     return message_transmitters;
 }
 
-static auto getAttributeValues(const AST::Network& net, const AST::Message& m, Cache const& cache)
+static auto getAttributeValues(const MessageCache* mc)
 {
     std::vector<std::unique_ptr<IAttribute>> attribute_values;
 
-    auto message_it = cache.Messages.find(m.id);
+    if (mc) {
+        attribute_values.reserve(mc->Attributes.size());
 
-    if (message_it != cache.Messages.end()) {
-        attribute_values.reserve(message_it->second.Attributes.size());
-
-        for (auto av: message_it->second.Attributes) {
+        for (auto av: mc->Attributes) {
             if (av->type == AST::AttributeValue_t::Type::Message) {
                 auto value = convertAttributeValue(av->value);
                 auto attribute = IAttribute::Create(std::string(av->attribute_name), IAttributeDefinition::EObjectType::Message, std::move(value));
@@ -367,20 +367,21 @@ static auto getAttributeValues(const AST::Network& net, const AST::Message& m, C
 }
 
 
-static auto getSignalGroups(const AST::Network& net, const AST::Message& m)
+static auto getSignalGroups(const MessageCache* mc)
 {
     std::vector<std::unique_ptr<ISignalGroup>> signal_groups;
-    for (const auto& sg : net.signal_groups)
+    if (!mc)
     {
-        if (sg.message_id == m.id)
-        {
-            auto signal_group = ISignalGroup::Create(
-                  sg.message_id
-                , std::string(sg.group_name)
-                , sg.repetitions
-                , std::vector<std::string>(sg.signal_names));
-            signal_groups.push_back(std::move(signal_group));
-        }
+        return signal_groups;
+    }
+    for (const auto* sg : mc->SignalGroups)
+    {
+        auto signal_group = ISignalGroup::Create(
+              sg->message_id
+            , std::string(sg->group_name)
+            , sg->repetitions
+            , std::vector<std::string>(sg->signal_names));
+        signal_groups.push_back(std::move(signal_group));
     }
     return signal_groups;
 }
@@ -393,10 +394,11 @@ static auto getMessages(const AST::Network& net, Cache const& cache)
 
     for (const auto& m : net.messages)
     {
-        auto message_transmitters = getMessageTransmitters(net, m);
-        auto signals = getSignals(net, m, cache);
-        auto attribute_values = getAttributeValues(net, m, cache);
-        auto signal_groups = getSignalGroups(net, m);
+        const MessageCache* mc = cache.FindMessage(m.id);
+        auto message_transmitters = getMessageTransmitters(mc);
+        auto signals = getSignals(m, mc);
+        auto attribute_values = getAttributeValues(mc);
+        auto signal_groups = getSignalGroups(mc);
         auto msg = IMessage::Create(
               m.id
             , std::string(m.name)
@@ -415,62 +417,6 @@ static auto getMessages(const AST::Network& net, Cache const& cache)
     return messages;
 }
 
-static auto getMessagesFiltered(const AST::Network& net, Cache const& cache,
-    INetwork::MessageFilter message_filter,
-    INetwork::SignalFilter signal_filter)
-{
-    std::vector<std::unique_ptr<IMessage>> messages;
-    uint32_t discarded_messages = 0;
-    uint32_t discarded_signals = 0;
-
-    for (const auto& m : net.messages)
-    {
-        // Check if we should keep this message
-        if (!message_filter(m.id, std::string(m.name))) {
-            discarded_messages++;
-            continue;
-        }
-
-        auto message_transmitters = getMessageTransmitters(net, m);
-
-        // Filter signals based on signal_filter
-        auto all_signals = getSignals(net, m, cache);
-        std::vector<std::unique_ptr<ISignal>> filtered_signals;
-        for (auto& sig : all_signals) {
-            if (signal_filter(sig->Name(), m.id)) {
-                filtered_signals.push_back(std::move(sig));
-            } else {
-                discarded_signals++;
-            }
-        }
-
-        auto attribute_values = getAttributeValues(net, m, cache);
-        auto signal_groups = getSignalGroups(net, m);
-
-        auto msg = IMessage::Create(
-              m.id
-            , std::string(m.name)
-            , m.size
-            , std::string(m.transmitter)
-            , std::move(message_transmitters)
-            , std::move(filtered_signals)
-            , std::move(attribute_values)
-            , std::move(signal_groups));
-
-        if (msg->Error() == IMessage::EErrorCode::MuxValeWithoutMuxSignal)
-        {
-            LOG_WARNING("Message '%s' has mux value but no mux signal!", msg->Name().c_str());
-        }
-        messages.emplace_back(std::move(msg));
-    }
-
-    if (discarded_messages > 0 || discarded_signals > 0) {
-        LOG_INFO("Filter discarded %u messages and %u signals", discarded_messages, discarded_signals);
-    }
-
-    return messages;
-}
-
 static auto getAttributeDefinitions(const AST::Network& net)
 {
     std::vector<std::unique_ptr<IAttributeDefinition>> attribute_definitions;
@@ -577,10 +523,16 @@ static auto getAttributeValues(const AST::Network& net, Cache const& cache)
 }
 
 
-std::unique_ptr<INetwork> DBCAST2Network(const AST::Network& net)
+static Cache buildCache(const AST::Network& net)
 {
     Cache cache;
 
+    cache.Messages.reserve(net.messages.size());
+    for (const auto& m : net.messages)
+    {
+        cache.Messages[m.id];
+    }
+
     // Build cache for attributes
     for (const auto& av : net.attribute_values)
     {
@@ -609,83 +561,83 @@ std::unique_ptr<INetwork> DBCAST2Network(const AST::Network& net)
         }
     }
 
-
-    return INetwork::Create(
-          getVersion(net)
-        , getNewSymbols(net)
-        , getBitTiming(net)
-        , getNodes(net, cache)
-        , getValueTables(net)
-        , getMessages(net, cache)
-        , getAttributeDefinitions(net)
-        , getAttributeDefaults(net)
-        , getAttributeValues(net, cache)
-);
+    // Like the linear searches this replaces, the first SIG_VALTYPE_,
+    // BO_TX_BU_ and SGTYPE_ for an object wins
+    for (const auto& sev : net.signal_extended_value_types)
+    {
+        auto& sc = cache.Messages[sev.message_id].Signals[sev.signal_name];
+        if (!sc.ExtendedValueType)
+        {
+            sc.ExtendedValueType = &sev;
+        }
+    }
+    for (const auto& smv : net.signal_multiplexer_values)
+    {
+        cache.Messages[smv.message_id].Signals[smv.signal_name].MultiplexerValues.push_back(&smv);
+    }
+    for (const auto& mt : net.message_transmitters)
+    {
+        auto& mc = cache.Messages[mt.message_id];
+        if (!mc.Transmitters)
+        {
+            mc.Transmitters = &mt;
+        }
+    }
+    for (const auto& sg : net.signal_groups)
+    {
+        cache.Messages[sg.message_id].SignalGroups.push_back(&sg);
+    }
+    for (const auto& st : net.signal_types)
+    {
+        cache.SignalTypes.emplace(st.value_table, &st);
+    }
+    return cache;
 }
 
-// Filtered version of DBCAST2Network
-std::unique_ptr<INetwork> DBCAST2NetworkFiltered(const AST::Network& net,
-    INetwork::MessageFilter message_filter,
-    INetwork::SignalFilter signal_filter)
+// Message and signal filters are applied by the parser (see DBCParser::setFilters),
+// the AST handed in here only contains what is going to be kept
+std::unique_ptr<INetwork> DBCAST2Network(const AST::Network& net)
 {
-    Cache cache;
+    Cache cache = buildCache(net);
 
-    // Build cache for attributes - only for messages/signals we'll keep
-    for (const auto& av : net.attribute_values)
+    // Repeated names (receivers, units, attribute names, ...) are interned into one pool
+    // owned by the network
+    auto strings = std::make_unique<StringPool>();
+    std::unique_ptr<INetwork> result;
     {
-        switch (av.type) {
-        case AST::AttributeValue_t::Type::Network:
-            cache.NetworkAttributes.emplace_back(&av);
-            break;
-        case AST::AttributeValue_t::Type::Node:
-            cache.Nodes[av.node_name].Attributes.emplace_back(&av);
-            break;
-        case AST::AttributeValue_t::Type::Message:
-            // Only cache if message will be kept
-            for (const auto& m : net.messages) {
-                if (m.id == av.message_id && message_filter(m.id, std::string(m.name))) {
-                    cache.Messages[av.message_id].Attributes.emplace_back(&av);
-                    break;
-                }
-            }
-            break;
-        case AST::AttributeValue_t::Type::Signal:
-            // Only cache if message will be kept
-            for (const auto& m : net.messages) {
-                if (m.id == av.message_id && message_filter(m.id, std::string(m.name))) {
-                    cache.Messages[av.message_id].Signals[av.signal_name].Attributes.emplace_back(&av);
-                    break;
-                }
-            }
-            break;
-        }
+        StringPoolScope scope(*strings);
+        result = INetwork::Create(
+              getVersion(net)
+            , getNewSymbols(net)
+            , getBitTiming(net)
+            , getNodes(net, cache)
+            , getValueTables(net, cache)
+            , getMessages(net, cache)
+            , getAttributeDefinitions(net)
+            , getAttributeDefaults(net)
+            , getAttributeValues(net, cache)
+        );
     }
+    static_cast<NetworkImpl&>(*result).AdoptStrings(std::move(strings));
+    return result;
+}
 
-    // Build cache for value descriptions - only for signals we'll keep
-    for (const auto& vd : net.value_descriptions)
-    {
-        if (vd.type == AST::ValueDescription::Type::Signal) {
-            // Check if message will be kept
-            for (const auto& m : net.messages) {
-                if (m.id == vd.message_id && message_filter(m.id, std::string(m.name))) {
-                    cache.Messages[vd.message_id].Signals[vd.object_name].ValueDescriptions = &vd;
-                    break;
-                }
-            }
-        }
-    }
+static std::unique_ptr<INetwork> LoadDBCFromBuffer(std::string_view content,
+    INetwork::MessageFilter message_filter,
+    INetwork::SignalFilter signal_filter)
+{
+    // The filters are evaluated by the parser, rejected messages and signals
+    // never make it into the AST
+    DBCParser parser;
+    parser.setFilters(std::move(message_filter), std::move(signal_filter));
+    auto parseResult = parser.parse(content);
 
-    return INetwork::Create(
-          getVersion(net)
-        , getNewSymbols(net)
-        , getBitTiming(net)
-        , getNodes(net, cache)
-        , getValueTables(net)
-        , getMessagesFiltered(net, cache, message_filter, signal_filter)
-        , getAttributeDefinitions(net)
-        , getAttributeDefaults(net)
-        , getAttributeValues(net, cache)
-    );
+    if (parseResult.isOk()) {
+        return DBCAST2Network(*parseResult.value());
+    } else {
+        LOG_ERROR("Parse error: %s", parseResult.error().toString().c_str());
+        return nullptr;
+    }
 }
 
 // Implementation without iostream
@@ -693,37 +645,114 @@ std::unique_ptr<INetwork> INetwork::LoadDBCFromFile(const char* filename,
     MessageFilter message_filter,
     SignalFilter signal_filter)
 {
-    // Use FileLineReader to read file without iostream
-    FileLineReader reader;
-    if (!reader.open(filename)) {
+    // Map the file (or read it into one buffer) and lex it in place
+    MappedFile file;
+    if (!file.open(filename)) {
         LOG_ERROR("Cannot open file: %s", filename);
         return nullptr;
     }
+    return LoadDBCFromBuffer(file.view(), message_filter, signal_filter);
+}
 
-    // Read entire file into string
-    std::string content;
-    std::string line;
-    while (reader.readLine(line)) {
-        content += line + "\n";
+static std::unique_ptr<INetwork> loadCached(const char* filename,
+    const INetwork::LoadOptions& options,
+    const INetwork::MessageFilter& message_filter,
+    const INetwork::SignalFilter& signal_filter)
+{
+    // filters without a key can't be told apart from no filters, such loads bypass the cache
+    bool unkeyed_filters = (message_filter || signal_filter) && options.filter_key.empty();
+    if (options.cache_dir.empty() || unkeyed_filters)
+    {
+        return INetwork::LoadDBCFromFile(filename, message_filter, signal_filter);
     }
-    reader.close();
-
-    // Use existing full parser with filters
-    return LoadDBCFromString(content, message_filter, signal_filter);
+    MappedFile file;
+    if (!file.open(filename)) {
+        LOG_ERROR("Cannot open file: %s", filename);
+        return nullptr;
+    }
+    // The snapshot version is part of the key so entries of older builds are never looked at
+    char entry[64];
+    std::snprintf(entry, sizeof(entry), "/%016llx-%016llx-v%u.snap",
+        static_cast<unsigned long long>(ContentHash::Hash(file.view())),
+        static_cast<unsigned long long>(ContentHash::Hash(options.filter_key)),
+        static_cast<unsigned>(snapshot::version));
+    std::string cache_file = options.cache_dir + entry;
+
+    // A missing or unusable entry is a miss, not an error
+    MappedFile cached;
+    if (cached.open(cache_file.c_str()))
+    {
+        NetworkSnapshot snapshot;
+        if (snapshot.Open(cached.view()))
+        {
+            return snapshot.Materialize();
+        }
+        LOG_WARNING("Ignoring invalid cache entry: %s", cache_file.c_str());
+    }
+    auto net = LoadDBCFromBuffer(file.view(), message_filter, signal_filter);
+    if (net && !net->SaveSnapshot(cache_file.c_str()))
+    {
+        LOG_WARNING("Cannot write cache entry: %s", cache_file.c_str());
+    }
+    return net;
 }
 
-std::unique_ptr<INetwork> INetwork::LoadDBCFromString(const std::string& content,
+std::unique_ptr<INetwork> INetwork::LoadDBCFromFile(const char* filename,
+    const LoadOptions& options,
     MessageFilter message_filter,
     SignalFilter signal_filter)
 {
-    // Use the existing full DBC parser that has complete implementation
-    DBCParser parser;
-    auto parseResult = parser.parse(content);
+    if (options.arena_block_size == 0)
+    {
+        return loadCached(filename, options, message_filter, signal_filter);
+    }
+    // Everything built while the scope is active allocates from the arena, temporaries of the
+    // load are destroyed before it ends and the network keeps the arena alive
+    auto arena = std::make_unique<Arena>(options.arena_block_size);
+    std::unique_ptr<INetwork> net;
+    {
+        ArenaScope scope(*arena);
+        net = loadCached(filename, options, message_filter, signal_filter);
+    }
+    if (net)
+    {
+        static_cast<NetworkImpl&>(*net).AdoptArena(std::move(arena));
+    }
+    return net;
+}
 
-    if (parseResult.isOk()) {
-        return DBCAST2NetworkFiltered(*parseResult.value(), message_filter, signal_filter);
-    } else {
-        LOG_ERROR("Parse error: %s", parseResult.error().toString().c_str());
-        return nullptr;
+Result<std::unique_ptr<INetwork>> INetwork::LoadDBCIntoStorage(const char* filename,
+    void* storage, std::size_t storage_size,
+    const LoadOptions& options,
+    MessageFilter message_filter,
+    SignalFilter signal_filter)
+{
+    auto arena = std::make_unique<Arena>(storage, storage_size);
+    std::unique_ptr<INetwork> net;
+    {
+        ArenaScope scope(*arena);
+        net = loadCached(filename, options, message_filter, signal_filter);
+    }
+    if (!net)
+    {
+        return Result<std::unique_ptr<INetwork>>(ParseErrorCode::LoadFailed,
+            std::string("Cannot load ") + filename, 0, 0);
+    }
+    if (arena->Exhausted())
+    {
+        // net still refers to the heap blocks of the arena, destroy it first
+        net.reset();
+        return Result<std::unique_ptr<INetwork>>(ParseErrorCode::CapacityExceeded,
+            "Network storage too small: " + std::to_string(arena->Used()) + " bytes needed, " +
+            std::to_string(storage_size) + " provided", 0, 0);
     }
-}
\ No newline at end of file
+    static_cast<NetworkImpl&>(*net).AdoptArena(std::move(arena));
+    return Result<std::unique_ptr<INetwork>>(std::move(net));
+}
+
+std::unique_ptr<INetwork> INetwork::LoadDBCFromString(const std::string& content,
+    MessageFilter message_filter,
+    SignalFilter signal_filter)
+{
+    return LoadDBCFromBuffer(content, message_filter, signal_filter);
+}
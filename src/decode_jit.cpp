@@ -0,0 +1,327 @@
+#include <cstring>
+#include <initializer_list>
+#include "decode_jit.h"
+
+#ifdef DBCPPP_JIT_X86_64
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+using namespace dbcppp;
+
+#ifdef DBCPPP_JIT_X86_64
+namespace
+{
+    // Encoder for the few instructions the decoders are made of. Register use: rdi frame,
+    // rsi output, r8/r9 first 8 bytes in little/big endian order, rax/rcx/rdx scratch,
+    // xmm0 the value being scaled. All of them are caller saved in the System V ABI.
+    class Assembler
+    {
+    public:
+        void Bytes(std::initializer_list<uint8_t> bytes)
+        {
+            _code.insert(_code.end(), bytes);
+        }
+        void Imm32(uint32_t v)
+        {
+            for (int i = 0; i < 4; i++) _code.push_back(uint8_t(v >> (8 * i)));
+        }
+        void Imm64(uint64_t v)
+        {
+            for (int i = 0; i < 8; i++) _code.push_back(uint8_t(v >> (8 * i)));
+        }
+        void Align(std::size_t alignment, uint8_t fill)
+        {
+            while (_code.size() % alignment) _code.push_back(fill);
+        }
+        // shl (4), shr (5) or sar (7) of rax or rdx by an immediate
+        void ShiftRax(uint8_t ext, uint64_t count)
+        {
+            if (count & 63)
+            {
+                Bytes({0x48, 0xC1, uint8_t(0xC0 | ext << 3), uint8_t(count & 63)});
+            }
+        }
+        void ShiftRdx(uint8_t ext, uint64_t count)
+        {
+            if (count & 63)
+            {
+                Bytes({0x48, 0xC1, uint8_t(0xC2 | ext << 3), uint8_t(count & 63)});
+            }
+        }
+        void AndRax(uint64_t mask)
+        {
+            if (mask == ~0ull)
+            {
+                return;
+            }
+            if (mask == 0xFFFFFFFFull)
+            {
+                Bytes({0x89, 0xC0});                    // mov eax, eax
+            }
+            else if (mask <= 0x7FFFFFFFull)
+            {
+                Bytes({0x25});                          // and eax, imm32
+                Imm32(uint32_t(mask));
+            }
+            else if ((mask & (mask + 1)) == 0)
+            {
+                uint64_t unused = 64 - __builtin_popcountll(mask);
+                ShiftRax(4, unused);
+                ShiftRax(5, unused);
+            }
+            else
+            {
+                Bytes({0x48, 0xB9});                    // mov rcx, imm64
+                Imm64(mask);
+                Bytes({0x48, 0x21, 0xC8});              // and rax, rcx
+            }
+        }
+        // mulsd (0x59) or addsd (0x58) xmm0 with a constant of the pool
+        void ScaleConst(uint8_t op, double value)
+        {
+            Bytes({0xF2, 0x0F, op, 0x05});
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            std::size_t index = 0;
+            while (index < _pool.size() && _pool[index] != bits) index++;
+            if (index == _pool.size())
+            {
+                _pool.push_back(bits);
+            }
+            _fixups.push_back({_code.size(), index});
+            Imm32(0);
+        }
+        std::size_t Size() const noexcept
+        {
+            return _code.size();
+        }
+        // appends the constant pool and resolves the rip relative references to it
+        void Link()
+        {
+            Align(8, 0xCC);
+            std::size_t pool = _code.size();
+            for (uint64_t bits : _pool)
+            {
+                Imm64(bits);
+            }
+            for (const auto& fixup : _fixups)
+            {
+                uint32_t disp = uint32_t(int32_t(pool + 8 * fixup.index) - int32_t(fixup.pos + 4));
+                for (int i = 0; i < 4; i++) _code[fixup.pos + i] = uint8_t(disp >> (8 * i));
+            }
+        }
+        const std::vector<uint8_t>& Code() const noexcept
+        {
+            return _code;
+        }
+
+    private:
+        struct Fixup
+        {
+            std::size_t pos;
+            std::size_t index;
+        };
+        std::vector<uint8_t> _code;
+        std::vector<uint64_t> _pool;
+        std::vector<Fixup> _fixups;
+    };
+
+    // DecodePlan::Extract followed by DecodePlan::RawToPhys and the store to out[i]
+    void EmitStep(Assembler& as, const DecodeStep& step, std::size_t i)
+    {
+        switch (step.kind)
+        {
+        case DecodeStep::EKind::FirstLittleEndian:
+            as.Bytes({0x4C, 0x89, 0xC0});               // mov rax, r8
+            break;
+        case DecodeStep::EKind::FirstBigEndian:
+            as.Bytes({0x4C, 0x89, 0xC8});               // mov rax, r9
+            break;
+        default:
+            as.Bytes({0x48, 0x8B, 0x87});               // mov rax, [rdi + byte_pos]
+            as.Imm32(step.byte_pos);
+            if (step.kind == DecodeStep::EKind::BigEndian || step.kind == DecodeStep::EKind::SpanBigEndian)
+            {
+                as.Bytes({0x48, 0x0F, 0xC8});           // bswap rax
+            }
+            break;
+        }
+        bool masked_by_sign_shift = step.sign_shift != 0 && step.mask == ~0ull >> step.sign_shift;
+        switch (step.kind)
+        {
+        case DecodeStep::EKind::SpanLittleEndian:
+            as.Bytes({0x0F, 0xB6, 0x97});               // movzx edx, byte [rdi + byte_pos + 8]
+            as.Imm32(step.byte_pos + 8u);
+            as.ShiftRax(5, step.shift0);
+            as.Bytes({0x81, 0xE2});                     // and edx, imm32
+            as.Imm32(uint32_t(step.mask & 0xFF));
+            as.ShiftRdx(4, step.shift1);
+            as.Bytes({0x48, 0x09, 0xD0});               // or rax, rdx
+            break;
+        case DecodeStep::EKind::SpanBigEndian:
+            as.Bytes({0x0F, 0xB6, 0x97});
+            as.Imm32(step.byte_pos + 8u);
+            as.AndRax(step.mask);
+            as.ShiftRax(4, step.shift0);
+            if (step.shift1 & 63)
+            {
+                as.Bytes({0xC1, 0xEA, uint8_t(step.shift1 & 63)}); // shr edx, imm8
+            }
+            as.Bytes({0x48, 0x09, 0xD0});
+            break;
+        default:
+            as.ShiftRax(5, step.shift0);
+            if (!masked_by_sign_shift)
+            {
+                as.AndRax(step.mask);
+            }
+            break;
+        }
+        as.ShiftRax(4, step.sign_shift);
+        as.ShiftRax(7, step.sign_shift);
+
+        bool integer = false;
+        switch (step.value)
+        {
+        case DecodeStep::EValue::Unsigned:
+            integer = true;
+            if (step.kind != DecodeStep::EKind::SpanLittleEndian && step.kind != DecodeStep::EKind::SpanBigEndian &&
+                (step.mask >> 63) == 0)
+            {
+                as.Bytes({0x0F, 0x57, 0xC0});           // xorps xmm0, xmm0
+                as.Bytes({0xF2, 0x48, 0x0F, 0x2A, 0xC0}); // cvtsi2sd xmm0, rax
+            }
+            else
+            {
+                // the compiler's uint64_t to double conversion: halve values with the top bit set
+                // keeping the lowest bit sticky, convert and double
+                as.Bytes({0x48, 0x85, 0xC0});           // test rax, rax
+                as.Bytes({0x78, 0x0A});                 // js big
+                as.Bytes({0x0F, 0x57, 0xC0});
+                as.Bytes({0xF2, 0x48, 0x0F, 0x2A, 0xC0});
+                as.Bytes({0xEB, 0x18});                 // jmp done
+                as.Bytes({0x48, 0x89, 0xC1});           // big: mov rcx, rax
+                as.Bytes({0x48, 0xD1, 0xE9});           // shr rcx, 1
+                as.Bytes({0x83, 0xE0, 0x01});           // and eax, 1
+                as.Bytes({0x48, 0x09, 0xC1});           // or rcx, rax
+                as.Bytes({0x0F, 0x57, 0xC0});
+                as.Bytes({0xF2, 0x48, 0x0F, 0x2A, 0xC1}); // cvtsi2sd xmm0, rcx
+                as.Bytes({0xF2, 0x0F, 0x58, 0xC0});     // addsd xmm0, xmm0
+            }                                           // done:
+            break;
+        case DecodeStep::EValue::Signed:
+            integer = true;
+            as.Bytes({0x0F, 0x57, 0xC0});
+            as.Bytes({0xF2, 0x48, 0x0F, 0x2A, 0xC0});
+            break;
+        case DecodeStep::EValue::Float:
+            as.Bytes({0x66, 0x0F, 0x6E, 0xC0});         // movd xmm0, eax
+            as.Bytes({0xF3, 0x0F, 0x5A, 0xC0});         // cvtss2sd xmm0, xmm0
+            break;
+        case DecodeStep::EValue::Double:
+            as.Bytes({0x66, 0x48, 0x0F, 0x6E, 0xC0});   // movq xmm0, rax
+            break;
+        }
+        // integers are exact in double, multiplying them by 1 doesn't change any bit
+        if (!integer || step.factor != 1.0)
+        {
+            as.ScaleConst(0x59, step.factor);           // mulsd xmm0, [rip + factor]
+        }
+        as.ScaleConst(0x58, step.offset);               // addsd xmm0, [rip + offset]
+        as.Bytes({0xF2, 0x0F, 0x11, 0x86});             // movsd [rsi + 8 * i], xmm0
+        as.Imm32(uint32_t(8 * i));
+    }
+    void EmitPlan(Assembler& as, const DecodePlan& plan)
+    {
+        bool first_le = false;
+        bool first_be = false;
+        for (std::size_t i = 0; i < plan.Size(); i++)
+        {
+            first_le |= plan[i].kind == DecodeStep::EKind::FirstLittleEndian;
+            first_be |= plan[i].kind == DecodeStep::EKind::FirstBigEndian;
+        }
+        if (first_le || first_be)
+        {
+            as.Bytes({0x4C, 0x8B, 0x07});               // mov r8, [rdi]
+        }
+        if (first_be)
+        {
+            as.Bytes({0x4D, 0x89, 0xC1});               // mov r9, r8
+            as.Bytes({0x49, 0x0F, 0xC9});               // bswap r9
+        }
+        for (std::size_t i = 0; i < plan.Size(); i++)
+        {
+            EmitStep(as, plan[i], i);
+        }
+        as.Bytes({0xC3});                               // ret
+    }
+}
+#endif
+
+DecodeJit::~DecodeJit()
+{
+    Release();
+}
+bool DecodeJit::Supported() noexcept
+{
+#ifdef DBCPPP_JIT_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+bool DecodeJit::Compile(const std::vector<const DecodePlan*>& plans)
+{
+    Release();
+#ifdef DBCPPP_JIT_X86_64
+    Assembler as;
+    std::vector<std::size_t> offsets;
+    offsets.reserve(plans.size());
+    for (const DecodePlan* plan : plans)
+    {
+        as.Align(16, 0xCC);
+        offsets.push_back(as.Size());
+        EmitPlan(as, *plan);
+    }
+    as.Link();
+
+    // written while writable, then switched to executable: never both at once
+    std::size_t page = std::size_t(sysconf(_SC_PAGESIZE));
+    std::size_t size = (as.Size() + page - 1) / page * page;
+    void* code = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED)
+    {
+        return false;
+    }
+    std::memcpy(code, as.Code().data(), as.Size());
+    if (mprotect(code, size, PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(code, size);
+        return false;
+    }
+    _code = code;
+    _size = size;
+    _entries.reserve(plans.size());
+    for (std::size_t offset : offsets)
+    {
+        _entries.push_back(reinterpret_cast<DecodePlan::native_decode_t>(static_cast<uint8_t*>(code) + offset));
+    }
+    return true;
+#else
+    (void)plans;
+    return false;
+#endif
+}
+void DecodeJit::Release() noexcept
+{
+#ifdef DBCPPP_JIT_X86_64
+    if (_code)
+    {
+        munmap(_code, _size);
+    }
+#endif
+    _code = nullptr;
+    _size = 0;
+    _entries.clear();
+}
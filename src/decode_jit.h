@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_features.h"
+#include "decode_plan.h"
+
+// The JIT emits System V x86-64 code into anonymous mappings. Scaling in single precision
+// (DBCPPP_COMPACT_DESCRIPTORS) isn't implemented, those plans stay on the portable loop.
+#if defined(DBCPPP_X86_DISPATCH) && defined(__unix__) && !defined(DBCPPP_COMPACT_DESCRIPTORS)
+#   define DBCPPP_JIT_X86_64
+#endif
+
+namespace dbcppp
+{
+    // Native code for DecodePlan::Decode: per plan one function which decodes every step with
+    // its byte position, shifts, mask, sign shift, factor and offset as immediates and stores
+    // the physical values straight into the output array, bit identical to the portable loop.
+    // All functions of one Compile() share one executable mapping owned by the DecodeJit, the
+    // plans have to be detached (DecodePlan::SetNative(nullptr)) before it is destroyed.
+    class DecodeJit
+    {
+    public:
+        DecodeJit() = default;
+        DecodeJit(const DecodeJit&) = delete;
+        DecodeJit& operator=(const DecodeJit&) = delete;
+        ~DecodeJit();
+
+        // false if this platform has no JIT backend
+        static bool Supported() noexcept;
+        // returns false if nothing could be compiled, Entry() of the plans is nullptr then
+        bool Compile(const std::vector<const DecodePlan*>& plans);
+        // function of plans[i] of the last Compile() or nullptr
+        DecodePlan::native_decode_t Entry(std::size_t i) const noexcept
+        {
+            return i < _entries.size() ? _entries[i] : nullptr;
+        }
+        // bytes of the executable mapping
+        std::size_t CodeSize() const noexcept
+        {
+            return _size;
+        }
+
+    private:
+        void Release() noexcept;
+
+        void* _code = nullptr;
+        std::size_t _size = 0;
+        std::vector<DecodePlan::native_decode_t> _entries;
+    };
+}
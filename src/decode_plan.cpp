@@ -0,0 +1,119 @@
+#include <algorithm>
+#include "decode_plan.h"
+
+using namespace dbcppp;
+
+DecodeStep DecodePlan::MakeStep(const SignalImpl& sig)
+{
+    DecodeStep step;
+    step.mask = sig._mask;
+    step.factor = sig._factor;
+    step.offset = sig._offset;
+    step.byte_pos = uint16_t(sig._byte_pos);
+    step.shift0 = sig._fixed_start_bit_0;
+    step.shift1 = sig._fixed_start_bit_1;
+    step.sign_shift = 0;
+    step.reserved = 0;
+    bool big_endian = sig.ByteOrder() == ISignal::EByteOrder::BigEndian;
+    switch (sig._alignment)
+    {
+    case Alignment::size_inbetween_first_64_bit:
+        step.kind = big_endian ? DecodeStep::EKind::FirstBigEndian : DecodeStep::EKind::FirstLittleEndian;
+        break;
+    case Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit:
+        step.kind = big_endian ? DecodeStep::EKind::BigEndian : DecodeStep::EKind::LittleEndian;
+        break;
+    case Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit:
+        step.kind = big_endian ? DecodeStep::EKind::SpanBigEndian : DecodeStep::EKind::SpanLittleEndian;
+        break;
+    case Alignment::signal_fits_into_32_bit:
+        // steps read 64 bits: from the preloaded first 8 bytes if the 32 bit load lies within
+        // them, otherwise from the 8 bytes ending where the 32 bit load ends
+        if (sig._byte_pos + 4 <= 8)
+        {
+            step.kind = big_endian ? DecodeStep::EKind::FirstBigEndian : DecodeStep::EKind::FirstLittleEndian;
+            step.byte_pos = 0;
+            step.shift0 = uint8_t(big_endian
+                ? sig._fixed_start_bit_0 + 32 - 8 * sig._byte_pos
+                : sig._fixed_start_bit_0 + 8 * sig._byte_pos);
+        }
+        else
+        {
+            step.kind = big_endian ? DecodeStep::EKind::BigEndian : DecodeStep::EKind::LittleEndian;
+            step.byte_pos = uint16_t(sig._byte_pos - 4);
+            step.shift0 = uint8_t(big_endian ? sig._fixed_start_bit_0 : sig._fixed_start_bit_0 + 32);
+        }
+        break;
+    }
+    switch (sig.ExtendedValueType())
+    {
+    case ISignal::EExtendedValueType::Integer:
+        step.value = sig.ValueType() == ISignal::EValueType::Signed
+            ? DecodeStep::EValue::Signed : DecodeStep::EValue::Unsigned;
+        if (step.value == DecodeStep::EValue::Signed)
+        {
+            step.sign_shift = sig._sign_shift;
+        }
+        break;
+    case ISignal::EExtendedValueType::Float:
+        step.value = DecodeStep::EValue::Float;
+        break;
+    case ISignal::EExtendedValueType::Double:
+        step.value = DecodeStep::EValue::Double;
+        // like template_decode, doubles which fit into one load are taken as is
+        if (sig._alignment != Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit)
+        {
+            step.shift0 = 0;
+            step.mask = ~0ull;
+        }
+        break;
+    }
+    return step;
+}
+std::size_t DecodePlan::StepExtent(const DecodeStep& step) noexcept
+{
+    switch (step.kind)
+    {
+    case DecodeStep::EKind::LittleEndian:
+    case DecodeStep::EKind::BigEndian:
+        return std::max<std::size_t>(8, step.byte_pos + 8);
+    case DecodeStep::EKind::SpanLittleEndian:
+    case DecodeStep::EKind::SpanBigEndian:
+        return std::max<std::size_t>(8, step.byte_pos + 9);
+    default:
+        return 8;
+    }
+}
+void DecodePlan::Build(const ArenaVector<SignalImpl>& signals)
+{
+    _steps.clear();
+    _steps.reserve(signals.size());
+    _extent = 8;
+    _native = nullptr;
+    for (const auto& sig : signals)
+    {
+        DecodeStep step = MakeStep(sig);
+        _extent = std::max(_extent, StepExtent(step));
+        _steps.push_back(step);
+    }
+}
+std::size_t DecodePlan::Decode(const void* bytes, std::size_t len, double* out) const noexcept
+{
+    Frame frame;
+    if (!Prepare(bytes, len, frame))
+    {
+        return 0;
+    }
+    if (_native)
+    {
+        _native(frame.data, out);
+        return _steps.size();
+    }
+    const DecodeStep* step = _steps.data();
+    const DecodeStep* end = step + _steps.size();
+    for (; step != end; ++step, ++out)
+    {
+        *out = RawToPhys(*step, Extract(*step, frame.data, frame.first_le, frame.first_be));
+    }
+    return _steps.size();
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+#include "helper.h"
+#include "signal_impl.h"
+
+namespace dbcppp
+{
+    // Flattened decode parameters of one signal. The fields mirror SignalImpl's
+    // precomputed _mask/_fixed_start_bit_*/_byte_pos/_sign_shift so a message can
+    // decode all of its signals from one contiguous array instead of chasing a
+    // function pointer per signal. Kept at 32 bytes (24 with DBCPPP_COMPACT_DESCRIPTORS),
+    // at least two steps per cache line.
+    struct DecodeStep
+    {
+        enum class EKind
+            : uint8_t
+        {
+            // signal lies within the first 8 bytes and is extracted from the preloaded word
+            FirstLittleEndian,
+            FirstBigEndian,
+            // signal fits into one 64 bit load at _byte_pos
+            LittleEndian,
+            BigEndian,
+            // signal spans 9 bytes and has to be composed from two loads
+            SpanLittleEndian,
+            SpanBigEndian
+        };
+        enum class EValue
+            : uint8_t
+        {
+            Unsigned,
+            Signed,
+            Float,
+            Double
+        };
+
+        uint64_t mask;
+        scale_t factor;
+        scale_t offset;
+        // frames are at most a few kilobytes (J1939 transport protocol: 1785 bytes)
+        uint16_t byte_pos;
+        uint8_t shift0;
+        uint8_t shift1;
+        EKind kind;
+        EValue value;
+        // 64 - bit size for signed integers, 0 otherwise: sign extension is a shift pair
+        // which leaves every other value untouched
+        uint8_t sign_shift;
+        uint8_t reserved;
+    };
+    static_assert(sizeof(DecodeStep) <= 32, "DecodeStep is sized to fit two per cache line");
+
+    class DecodePlan
+    {
+    public:
+        // frames shorter than the plan's read extent are zero padded on the stack,
+        // plans reading further than this are only decoded from frames that are long enough
+        static constexpr std::size_t max_padded_extent = 128;
+
+        // compiled Decode (see DecodeJit), data holds at least Extent() bytes
+        using native_decode_t = void (*)(const uint8_t* data, double* out);
+
+        DecodePlan() = default;
+        // copies don't share the native code, it belongs to the network the plan was compiled for
+        DecodePlan(const DecodePlan& other)
+            : _steps(other._steps)
+            , _extent(other._extent)
+        {}
+        DecodePlan(DecodePlan&& other) = default;
+        DecodePlan& operator=(const DecodePlan& other)
+        {
+            _steps = other._steps;
+            _extent = other._extent;
+            _native = nullptr;
+            return *this;
+        }
+        DecodePlan& operator=(DecodePlan&& other) = default;
+
+        // a frame ready for extraction, data points either to the caller's bytes or to padded
+        struct Frame
+        {
+            const uint8_t* data;
+            uint64_t first_le;
+            uint64_t first_be;
+            uint8_t padded[max_padded_extent];
+
+            Frame() = default;
+            Frame(const Frame&) = delete;
+            Frame& operator=(const Frame&) = delete;
+        };
+
+        static DecodeStep MakeStep(const SignalImpl& sig);
+        // number of bytes Extract reads for this step, at least the preloaded 8
+        static std::size_t StepExtent(const DecodeStep& step) noexcept;
+        void Build(const ArenaVector<SignalImpl>& signals);
+
+        // returns false if the frame is too short and the plan reads too far to pad it
+        inline bool Prepare(const void* bytes, std::size_t len, Frame& frame) const noexcept
+        {
+            return Prepare(bytes, len, _extent, frame);
+        }
+        // extent is the number of bytes the steps decoded from frame read
+        static inline bool Prepare(const void* bytes, std::size_t len, std::size_t extent, Frame& frame) noexcept
+        {
+            frame.data = reinterpret_cast<const uint8_t*>(bytes);
+            if (len < extent)
+            {
+                if (extent > max_padded_extent)
+                {
+                    return false;
+                }
+                std::memset(frame.padded, 0, extent);
+                if (len != 0)
+                {
+                    std::memcpy(frame.padded, bytes, len);
+                }
+                frame.data = frame.padded;
+            }
+            frame.first_le = Load64(frame.data);
+            frame.first_be = frame.first_le;
+            native_to_little_inplace(frame.first_le);
+            native_to_big_inplace(frame.first_be);
+            return true;
+        }
+        inline uint64_t Raw(const Frame& frame, std::size_t i) const noexcept
+        {
+            return Extract(_steps[i], frame.data, frame.first_le, frame.first_be);
+        }
+        inline double Phys(const Frame& frame, std::size_t i) const noexcept
+        {
+            const DecodeStep& step = _steps[i];
+            return RawToPhys(step, Extract(step, frame.data, frame.first_le, frame.first_be));
+        }
+
+        // writes one physical value per signal into out, in signal order,
+        // returns the number of values written (0 if the frame is too short to pad)
+        std::size_t Decode(const void* bytes, std::size_t len, double* out) const noexcept;
+
+        std::size_t Size() const noexcept
+        {
+            return _steps.size();
+        }
+        // number of bytes Decode reads from the frame
+        std::size_t Extent() const noexcept
+        {
+            return _extent;
+        }
+        const DecodeStep& operator[](std::size_t i) const noexcept
+        {
+            return _steps[i];
+        }
+        // Decode runs fn instead of the portable loop while it is set
+        void SetNative(native_decode_t fn) noexcept
+        {
+            _native = fn;
+        }
+        native_decode_t Native() const noexcept
+        {
+            return _native;
+        }
+
+        static inline uint64_t Load64(const uint8_t* p) noexcept
+        {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        // first_le/first_be are the first 8 bytes of data in little/big endian order
+        static inline uint64_t Extract(const DecodeStep& step, const uint8_t* data, uint64_t first_le, uint64_t first_be) noexcept
+        {
+            uint64_t raw;
+            switch (step.kind)
+            {
+            case DecodeStep::EKind::FirstLittleEndian:
+                raw = (first_le >> step.shift0) & step.mask;
+                break;
+            case DecodeStep::EKind::FirstBigEndian:
+                raw = (first_be >> step.shift0) & step.mask;
+                break;
+            case DecodeStep::EKind::LittleEndian:
+            {
+                uint64_t data0 = Load64(data + step.byte_pos);
+                native_to_little_inplace(data0);
+                raw = (data0 >> step.shift0) & step.mask;
+                break;
+            }
+            case DecodeStep::EKind::BigEndian:
+            {
+                uint64_t data0 = Load64(data + step.byte_pos);
+                native_to_big_inplace(data0);
+                raw = (data0 >> step.shift0) & step.mask;
+                break;
+            }
+            case DecodeStep::EKind::SpanLittleEndian:
+            {
+                uint64_t data0 = Load64(data + step.byte_pos);
+                uint64_t data1 = data[step.byte_pos + 8];
+                native_to_little_inplace(data0);
+                raw = (data0 >> step.shift0) | ((data1 & step.mask) << step.shift1);
+                break;
+            }
+            default:
+            {
+                uint64_t data0 = Load64(data + step.byte_pos);
+                uint64_t data1 = data[step.byte_pos + 8];
+                native_to_big_inplace(data0);
+                raw = ((data0 & step.mask) << step.shift0) | (data1 >> step.shift1);
+                break;
+            }
+            }
+            return uint64_t(int64_t(raw << step.sign_shift) >> step.sign_shift);
+        }
+        // scales like SignalImpl's raw_to_phys: in scale_t precision, doubles in double precision
+        static inline double RawToPhys(const DecodeStep& step, uint64_t raw) noexcept
+        {
+            scale_t draw;
+            switch (step.value)
+            {
+            case DecodeStep::EValue::Unsigned:
+                draw = scale_t(raw);
+                break;
+            case DecodeStep::EValue::Signed:
+                draw = scale_t(int64_t(raw));
+                break;
+            case DecodeStep::EValue::Float:
+            {
+                uint32_t raw32 = uint32_t(raw);
+                float f;
+                std::memcpy(&f, &raw32, sizeof(f));
+                draw = scale_t(f);
+                break;
+            }
+            default:
+            {
+                double d;
+                std::memcpy(&d, &raw, sizeof(d));
+                return d * step.factor + step.offset;
+            }
+            }
+            return draw * step.factor + step.offset;
+        }
+
+    private:
+        ArenaVector<DecodeStep> _steps;
+        std::size_t _extent = 8;
+        native_decode_t _native = nullptr;
+    };
+}
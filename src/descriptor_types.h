@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dbcppp
+{
+    // Enum stored in one byte, converts to and from the enum like the enum itself
+    template <class E>
+    class PackedEnum
+    {
+    public:
+        PackedEnum() = default;
+        PackedEnum(E value) noexcept
+            : _value(uint8_t(value))
+        {}
+        operator E() const noexcept
+        {
+            return E(_value);
+        }
+
+    private:
+        uint8_t _value;
+    };
+
+    // Storage types of the signal descriptors. By default they are the types of the public
+    // interface. Built with DBCPPP_COMPACT_DESCRIPTORS (CMake option of the same name), bit positions
+    // are stored in 16 bit, enums in one byte and factor, offset, minimum and maximum in single
+    // precision, and integer signals within 4 bytes are decoded with 32 bit loads and arithmetic.
+    // The getters then return the float rounded values and RawToPhys scales in single precision,
+    // except for signals of extended value type double.
+#ifdef DBCPPP_COMPACT_DESCRIPTORS
+    using scale_t = float;
+    using bit_pos_t = uint16_t;
+    using byte_pos_t = uint16_t;
+    template <class E>
+    using enum_storage_t = PackedEnum<E>;
+#else
+    using scale_t = double;
+    using bit_pos_t = uint64_t;
+    using byte_pos_t = uint32_t;
+    template <class E>
+    using enum_storage_t = E;
+#endif
+}
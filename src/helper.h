@@ -48,6 +48,20 @@
 
 namespace dbcppp
 {
+    inline void native_to_big_inplace(uint32_t& value)
+    {
+        if constexpr (dbcppp::Endian::Native == dbcppp::Endian::Little)
+        {
+            value = bswap_32(value);
+        }
+    }
+    inline void native_to_little_inplace(uint32_t& value)
+    {
+        if constexpr (dbcppp::Endian::Native == dbcppp::Endian::Big)
+        {
+            value = bswap_32(value);
+        }
+    }
     inline void native_to_big_inplace(uint64_t& value)
     {
         if constexpr (dbcppp::Endian::Native == dbcppp::Endian::Little)
@@ -0,0 +1,86 @@
+#include <cstdio>
+#include "mapped_file.h"
+
+#ifdef DBCPPP_HAVE_MMAP
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#endif
+
+using namespace dbcppp;
+
+bool MappedFile::open(const char* filename, bool allow_mmap) {
+    close();
+#ifdef DBCPPP_HAVE_MMAP
+    if (allow_mmap) {
+        int fd = ::open(filename, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* addr = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+                ::madvise(addr, size_t(st.st_size), MADV_SEQUENTIAL);
+#endif
+                ::close(fd);
+                data_ = static_cast<const char*>(addr);
+                size_ = size_t(st.st_size);
+                mapped_ = true;
+                open_ = true;
+                return true;
+            }
+        }
+        ::close(fd);
+    }
+#else
+    (void)allow_mmap;
+#endif
+    return readAll(filename);
+}
+
+bool MappedFile::readAll(const char* filename) {
+    FILE* file = std::fopen(filename, "rb");
+    if (!file) {
+        return false;
+    }
+    // size the buffer up front when the file is seekable, then read in large chunks
+    if (std::fseek(file, 0, SEEK_END) == 0) {
+        long size = std::ftell(file);
+        if (size > 0) {
+            buffer_.reserve(size_t(size));
+        }
+        std::fseek(file, 0, SEEK_SET);
+    }
+    char chunk[16 * 1024];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer_.append(chunk, n);
+    }
+    bool ok = !std::ferror(file);
+    std::fclose(file);
+    if (!ok) {
+        buffer_.clear();
+        return false;
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef DBCPPP_HAVE_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+}
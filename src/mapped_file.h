@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(ESP_PLATFORM)
+#   define DBCPPP_HAVE_MMAP
+#endif
+
+namespace dbcppp {
+
+// Read-only view of a whole file.
+// The file is memory mapped where mmap is available, otherwise (or if mapping fails)
+// it is read into one buffer with a single allocation. Either way the content is
+// never copied line by line, so the lexer can work directly on view().
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() {
+        close();
+    }
+
+    // allow_mmap = false forces the read() fallback
+    bool open(const char* filename, bool allow_mmap = true);
+    void close();
+
+    std::string_view view() const {
+        return std::string_view(data_, size_);
+    }
+    bool isOpen() const {
+        return open_;
+    }
+    bool isMapped() const {
+        return mapped_;
+    }
+
+private:
+    bool readAll(const char* filename);
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+    bool mapped_ = false;
+    std::string buffer_;
+
+    // Disable copy
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+} // namespace dbcppp
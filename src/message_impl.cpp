@@ -14,9 +14,12 @@ std::unique_ptr<IMessage> IMessage::Create(
     , std::vector<std::unique_ptr<IAttribute>>&& attribute_values
     , std::vector<std::unique_ptr<ISignalGroup>>&& signal_groups)
 {
-    std::vector<SignalImpl> ss;
-    std::vector<AttributeImpl> avs;
-    std::vector<SignalGroupImpl> sgs;
+    ArenaVector<SignalImpl> ss;
+    ArenaVector<AttributeImpl> avs;
+    ArenaVector<SignalGroupImpl> sgs;
+    ss.reserve(signals_.size());
+    avs.reserve(attribute_values.size());
+    sgs.reserve(signal_groups.size());
     for (auto& s : signals_)
     {
         ss.push_back(std::move(static_cast<SignalImpl&>(*s)));
@@ -48,19 +51,20 @@ MessageImpl::MessageImpl(
     , uint64_t message_size
     , std::string&& transmitter
     , std::vector<std::string>&& message_transmitters
-    , std::vector<SignalImpl>&& signals_
-    , std::vector<AttributeImpl>&& attribute_values
-    , std::vector<SignalGroupImpl>&& signal_groups)
+    , ArenaVector<SignalImpl>&& signals_
+    , ArenaVector<AttributeImpl>&& attribute_values
+    , ArenaVector<SignalGroupImpl>&& signal_groups)
     
     : _id(std::move(id))
     , _name(std::move(name))
     , _message_size(std::move(message_size))
     , _transmitter(std::move(transmitter))
-    , _message_transmitters(std::move(message_transmitters))
+    , _message_transmitters(std::make_move_iterator(message_transmitters.begin()), std::make_move_iterator(message_transmitters.end()))
     , _signals(std::move(signals_))
     , _attribute_values(std::move(attribute_values))
     , _signal_groups(std::move(signal_groups))
     , _mux_signal(nullptr)
+    , _mux_index(MuxDispatch::npos)
     , _error(EErrorCode::NoError)
 {
     bool have_mux_value = false;
@@ -83,6 +87,14 @@ MessageImpl::MessageImpl(
     {
         _error = EErrorCode::MuxValeWithoutMuxSignal;
     }
+    if (_mux_signal != nullptr)
+    {
+        _mux_index = static_cast<const SignalImpl*>(_mux_signal) - _signals.data();
+    }
+    _decode_plan.Build(_signals);
+    _mux_dispatch.Build(_signals, _mux_index);
+    _mux_tree.Build(_signals, _mux_index);
+    LinkSignals();
 }
 MessageImpl::MessageImpl(const MessageImpl& other)
 {
@@ -107,7 +119,30 @@ MessageImpl::MessageImpl(const MessageImpl& other)
             break;
         }
     }
+    _mux_index = other._mux_index;
+    _decode_plan = other._decode_plan;
+    _mux_dispatch = other._mux_dispatch;
+    _mux_tree = other._mux_tree;
     _error = other._error;
+    LinkSignals();
+}
+MessageImpl::MessageImpl(MessageImpl&& other) noexcept
+    : _id(other._id)
+    , _name(std::move(other._name))
+    , _message_size(other._message_size)
+    , _transmitter(std::move(other._transmitter))
+    , _message_transmitters(std::move(other._message_transmitters))
+    , _signals(std::move(other._signals))
+    , _attribute_values(std::move(other._attribute_values))
+    , _signal_groups(std::move(other._signal_groups))
+    , _mux_signal(other._mux_signal)
+    , _mux_index(other._mux_index)
+    , _decode_plan(std::move(other._decode_plan))
+    , _mux_dispatch(std::move(other._mux_dispatch))
+    , _mux_tree(std::move(other._mux_tree))
+    , _error(other._error)
+{
+    LinkSignals();
 }
 MessageImpl& MessageImpl::operator=(const MessageImpl& other)
 {
@@ -132,9 +167,40 @@ MessageImpl& MessageImpl::operator=(const MessageImpl& other)
             break;
         }
     }
+    _mux_index = other._mux_index;
+    _decode_plan = other._decode_plan;
+    _mux_dispatch = other._mux_dispatch;
+    _mux_tree = other._mux_tree;
+    _error = other._error;
+    LinkSignals();
+    return *this;
+}
+MessageImpl& MessageImpl::operator=(MessageImpl&& other) noexcept
+{
+    _id = other._id;
+    _name = std::move(other._name);
+    _message_size = other._message_size;
+    _transmitter = std::move(other._transmitter);
+    _message_transmitters = std::move(other._message_transmitters);
+    _signals = std::move(other._signals);
+    _attribute_values = std::move(other._attribute_values);
+    _signal_groups = std::move(other._signal_groups);
+    _mux_signal = other._mux_signal;
+    _mux_index = other._mux_index;
+    _decode_plan = std::move(other._decode_plan);
+    _mux_dispatch = std::move(other._mux_dispatch);
+    _mux_tree = std::move(other._mux_tree);
     _error = other._error;
+    LinkSignals();
     return *this;
 }
+void MessageImpl::LinkSignals() noexcept
+{
+    for (auto& sig : _signals)
+    {
+        sig.SetMessage(this);
+    }
+}
 uint64_t MessageImpl::Id() const
 {
     return _id;
@@ -167,6 +233,10 @@ uint64_t MessageImpl::Signals_Size() const
 {
     return _signals.size();
 }
+ObjectSpan<ISignal> MessageImpl::Signals() const
+{
+    return {_signals.data(), _signals.size()};
+}
 const IAttribute& MessageImpl::AttributeValues_Get(std::size_t i) const
 {
     return _attribute_values[i];
@@ -175,6 +245,10 @@ uint64_t MessageImpl::AttributeValues_Size() const
 {
     return _attribute_values.size();
 }
+ObjectSpan<IAttribute> MessageImpl::AttributeValues() const
+{
+    return {_attribute_values.data(), _attribute_values.size()};
+}
 const ISignalGroup& MessageImpl::SignalGroups_Get(std::size_t i) const
 {
     return _signal_groups[i];
@@ -183,16 +257,64 @@ uint64_t MessageImpl::SignalGroups_Size() const
 {
     return _signal_groups.size();
 }
+ObjectSpan<ISignalGroup> MessageImpl::SignalGroups() const
+{
+    return {_signal_groups.data(), _signal_groups.size()};
+}
 const ISignal* MessageImpl::MuxSignal() const 
 {
     return _mux_signal;
 }
+std::size_t MessageImpl::DecodeAll(const void* bytes, std::size_t len, double* out) const noexcept
+{
+    return _decode_plan.Decode(bytes, len, out);
+}
+std::size_t MessageImpl::DecodeActive(const void* bytes, std::size_t len, std::size_t* indices, double* values) const noexcept
+{
+    DecodePlan::Frame frame;
+    if (!_decode_plan.Prepare(bytes, len, frame))
+    {
+        return 0;
+    }
+    if (!_mux_tree.Empty())
+    {
+        MuxTree::State state;
+        _mux_tree.Evaluate(_decode_plan, frame, state);
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < _signals.size(); i++)
+        {
+            if (_mux_tree.Active(state, i))
+            {
+                indices[n] = i;
+                values[n] = _decode_plan.Phys(frame, i);
+                n++;
+            }
+        }
+        return n;
+    }
+    uint64_t switch_value = _mux_index != MuxDispatch::npos ? _decode_plan.Raw(frame, _mux_index) : 0;
+    MuxDispatch::Page page = _mux_dispatch.Find(switch_value);
+    for (std::size_t i = 0; i < page.size; i++)
+    {
+        indices[i] = page.indices[i];
+        values[i] = _decode_plan.Phys(frame, page.indices[i]);
+    }
+    return page.size;
+}
 MessageImpl::EErrorCode MessageImpl::Error() const
 {
     return _error;
 }
 
-const std::vector<SignalImpl>& MessageImpl::signals() const
+const ArenaVector<SignalImpl>& MessageImpl::signals() const
 {
     return _signals;
 }
+const DecodePlan& MessageImpl::decodePlan() const
+{
+    return _decode_plan;
+}
+DecodePlan& MessageImpl::decodePlan()
+{
+    return _decode_plan;
+}
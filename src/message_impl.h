@@ -5,6 +5,9 @@
 #include "node_impl.h"
 #include "attribute_impl.h"
 #include "signal_group_impl.h"
+#include "decode_plan.h"
+#include "mux_dispatch.h"
+#include "mux_tree.h"
 
 namespace dbcppp
 {
@@ -18,13 +21,13 @@ namespace dbcppp
             , uint64_t message_size
             , std::string&& transmitter
             , std::vector<std::string>&& message_transmitters
-            , std::vector<SignalImpl>&& signals_
-            , std::vector<AttributeImpl>&& attribute_values
-            , std::vector<SignalGroupImpl>&& signal_groups);
+            , ArenaVector<SignalImpl>&& signals_
+            , ArenaVector<AttributeImpl>&& attribute_values
+            , ArenaVector<SignalGroupImpl>&& signal_groups);
         MessageImpl(const MessageImpl& other);
-        MessageImpl(MessageImpl&& other) = default;
+        MessageImpl(MessageImpl&& other) noexcept;
         MessageImpl& operator=(const MessageImpl& other);
-        MessageImpl& operator=(MessageImpl&&) = default;
+        MessageImpl& operator=(MessageImpl&& other) noexcept;
             
         virtual uint64_t Id() const override;
         virtual const std::string& Name() const override;
@@ -34,27 +37,41 @@ namespace dbcppp
         virtual uint64_t MessageTransmitters_Size() const override;
         virtual const ISignal& Signals_Get(std::size_t i) const override;
         virtual uint64_t Signals_Size() const override;
+        virtual ObjectSpan<ISignal> Signals() const override;
         virtual const IAttribute& AttributeValues_Get(std::size_t i) const override;
         virtual uint64_t AttributeValues_Size() const override;
+        virtual ObjectSpan<IAttribute> AttributeValues() const override;
         virtual const ISignalGroup& SignalGroups_Get(std::size_t i) const override;
         virtual uint64_t SignalGroups_Size() const override;
+        virtual ObjectSpan<ISignalGroup> SignalGroups() const override;
         virtual const ISignal* MuxSignal() const override;
+        virtual std::size_t DecodeAll(const void* bytes, std::size_t len, double* out) const noexcept override;
+        virtual std::size_t DecodeActive(const void* bytes, std::size_t len, std::size_t* indices, double* values) const noexcept override;
         
         virtual EErrorCode Error() const override;
         
-        const std::vector<SignalImpl>& signals() const;
+        const ArenaVector<SignalImpl>& signals() const;
+        const DecodePlan& decodePlan() const;
+        DecodePlan& decodePlan();
         
     private:
+        // points the signals back to this message, after every construction and assignment
+        void LinkSignals() noexcept;
+
         uint64_t _id;
         std::string _name;
         uint64_t _message_size;
-        std::string _transmitter;
-        std::vector<std::string> _message_transmitters;
-        std::vector<SignalImpl> _signals;
-        std::vector<AttributeImpl> _attribute_values;
-        std::vector<SignalGroupImpl> _signal_groups;
+        PooledString _transmitter;
+        ArenaVector<PooledString> _message_transmitters;
+        ArenaVector<SignalImpl> _signals;
+        ArenaVector<AttributeImpl> _attribute_values;
+        ArenaVector<SignalGroupImpl> _signal_groups;
 
         const ISignal* _mux_signal;
+        std::size_t _mux_index;
+        DecodePlan _decode_plan;
+        MuxDispatch _mux_dispatch;
+        MuxTree _mux_tree;
 
         EErrorCode _error;
     };
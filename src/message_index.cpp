@@ -0,0 +1,66 @@
+#include "message_index.h"
+
+using namespace dbcppp;
+
+void MessageIndex::Build(const std::vector<uint64_t>& ids)
+{
+    _standard.clear();
+    _slots.clear();
+    _slot_mask = 0;
+    _hash_shift = 64;
+
+    bool have_standard = false;
+    std::size_t n_extended = 0;
+    for (auto id : ids)
+    {
+        if (id < standard_id_count)
+        {
+            have_standard = true;
+        }
+        else
+        {
+            n_extended++;
+        }
+    }
+    if (have_standard)
+    {
+        _standard.resize(standard_id_count, npos);
+    }
+    if (n_extended != 0)
+    {
+        // keep the load factor at or below 50% so probe sequences stay within a cache line
+        uint32_t bits = 1;
+        while ((std::size_t(1) << bits) < n_extended * 2)
+        {
+            bits++;
+        }
+        _slots.resize(std::size_t(1) << bits, Slot{0, npos});
+        _slot_mask = _slots.size() - 1;
+        _hash_shift = 64 - bits;
+    }
+    for (std::size_t i = 0; i < ids.size(); i++)
+    {
+        uint64_t id = ids[i];
+        if (id < standard_id_count)
+        {
+            if (_standard[id] == npos)
+            {
+                _standard[id] = uint32_t(i);
+            }
+            continue;
+        }
+        for (std::size_t s = Hash(id);; s = (s + 1) & _slot_mask)
+        {
+            Slot& slot = _slots[s];
+            if (slot.index == npos)
+            {
+                slot = Slot{id, uint32_t(i)};
+                break;
+            }
+            if (slot.id == id)
+            {
+                break;
+            }
+        }
+    }
+}
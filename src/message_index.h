@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "arena.h"
+
+namespace dbcppp
+{
+    // Immutable CAN-ID -> message position index, built once at load time.
+    // 11-bit IDs resolve through a direct table, all other IDs (29-bit IDs carrying
+    // the bit-31 extended flag like they do in DBC files) through a linear probing
+    // hash table. IDs are matched exactly, so 0x100 and 0x80000100 are different keys.
+    class MessageIndex
+    {
+    public:
+        static constexpr uint32_t npos = 0xFFFFFFFF;
+        static constexpr uint64_t standard_id_count = 0x800;
+
+        // ids[i] is the id of message i; on duplicate ids the first message wins
+        void Build(const std::vector<uint64_t>& ids);
+
+        inline uint32_t Find(uint64_t id) const noexcept
+        {
+            if (id < standard_id_count)
+            {
+                return _standard.empty() ? npos : _standard[id];
+            }
+            if (_slots.empty())
+            {
+                return npos;
+            }
+            for (std::size_t i = Hash(id);; i = (i + 1) & _slot_mask)
+            {
+                const Slot& slot = _slots[i];
+                if (slot.index == npos || slot.id == id)
+                {
+                    return slot.index;
+                }
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            uint64_t id;
+            uint32_t index;
+        };
+
+        inline std::size_t Hash(uint64_t id) const noexcept
+        {
+            return std::size_t((id * 0x9E3779B97F4A7C15ull) >> _hash_shift);
+        }
+
+        ArenaVector<uint32_t> _standard;
+        ArenaVector<Slot> _slots;
+        std::size_t _slot_mask = 0;
+        uint32_t _hash_shift = 64;
+    };
+}
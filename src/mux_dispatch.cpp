@@ -0,0 +1,67 @@
+#include <algorithm>
+#include "mux_dispatch.h"
+
+using namespace dbcppp;
+
+void MuxDispatch::Build(const ArenaVector<SignalImpl>& signals, std::size_t mux_index)
+{
+    _offsets.clear();
+    _indices.clear();
+    _direct.clear();
+    _sorted.clear();
+
+    // collect the distinct switch values, MuxValue signals without a switch signal are never active
+    std::vector<uint64_t> values;
+    if (mux_index != npos)
+    {
+        for (const auto& sig : signals)
+        {
+            if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
+            {
+                values.push_back(sig.MultiplexerSwitchValue());
+            }
+        }
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+    auto append_page = [&](const uint64_t* value)
+    {
+        _offsets.push_back(uint32_t(_indices.size()));
+        for (std::size_t i = 0; i < signals.size(); i++)
+        {
+            const auto& sig = signals[i];
+            if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue ||
+                (value && sig.MultiplexerSwitchValue() == *value))
+            {
+                _indices.push_back(uint32_t(i));
+            }
+        }
+    };
+    append_page(nullptr);
+    for (const auto& value : values)
+    {
+        append_page(&value);
+    }
+    _offsets.push_back(uint32_t(_indices.size()));
+
+    if (values.empty())
+    {
+        return;
+    }
+    if (values.back() < max_direct_value)
+    {
+        _direct.resize(std::size_t(values.back()) + 1, 0);
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            _direct[std::size_t(values[i])] = uint32_t(i + 1);
+        }
+    }
+    else
+    {
+        _sorted.reserve(values.size());
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            _sorted.push_back(ValuePage{values[i], uint32_t(i + 1)});
+        }
+    }
+}
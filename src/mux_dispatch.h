@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "signal_impl.h"
+
+namespace dbcppp
+{
+    // Per message table of the signals active for each multiplexer switch value.
+    // Every page lists the always present signals (NoMux and the switch itself) together
+    // with the MuxValue signals of that switch value, in signal order. Page 0 is used for
+    // switch values no signal is defined for. The switch value is mapped to its page through
+    // a direct table when the values are small, otherwise through a sorted array.
+    class MuxDispatch
+    {
+    public:
+        static constexpr uint64_t max_direct_value = 1024;
+        static constexpr std::size_t npos = std::size_t(-1);
+
+        struct Page
+        {
+            const uint32_t* indices;
+            std::size_t size;
+        };
+
+        // mux_index is the position of the switch signal in signals or npos if there is none
+        void Build(const ArenaVector<SignalImpl>& signals, std::size_t mux_index);
+
+        inline Page Find(uint64_t switch_value) const noexcept
+        {
+            uint32_t page = 0;
+            if (!_direct.empty())
+            {
+                if (switch_value < _direct.size())
+                {
+                    page = _direct[switch_value];
+                }
+            }
+            else if (!_sorted.empty())
+            {
+                std::size_t lo = 0;
+                std::size_t hi = _sorted.size();
+                while (lo < hi)
+                {
+                    std::size_t mid = (lo + hi) / 2;
+                    if (_sorted[mid].value < switch_value)
+                    {
+                        lo = mid + 1;
+                    }
+                    else
+                    {
+                        hi = mid;
+                    }
+                }
+                if (lo < _sorted.size() && _sorted[lo].value == switch_value)
+                {
+                    page = _sorted[lo].page;
+                }
+            }
+            return Page{_indices.data() + _offsets[page], std::size_t(_offsets[page + 1] - _offsets[page])};
+        }
+        std::size_t PageCount() const noexcept
+        {
+            return _offsets.size() - 1;
+        }
+
+    private:
+        struct ValuePage
+        {
+            uint64_t value;
+            uint32_t page;
+        };
+
+        // page i covers _indices[_offsets[i], _offsets[i + 1])
+        ArenaVector<uint32_t> _offsets{0, 0};
+        ArenaVector<uint32_t> _indices;
+        ArenaVector<uint32_t> _direct;
+        ArenaVector<ValuePage> _sorted;
+    };
+}
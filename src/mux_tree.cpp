@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <functional>
+#include "mux_tree.h"
+#include "mux_dispatch.h"
+
+using namespace dbcppp;
+
+bool MuxTree::Build(const ArenaVector<SignalImpl>& signals, std::size_t mux_index)
+{
+    constexpr std::size_t npos = MuxDispatch::npos;
+
+    _conditions.clear();
+    _switches.clear();
+    _ranges.clear();
+
+    bool extended = std::any_of(signals.begin(), signals.end(),
+        [](const SignalImpl& sig) { return sig.SignalMultiplexerValues_Size() != 0; });
+    if (!extended)
+    {
+        return false;
+    }
+
+    std::size_t n = signals.size();
+    std::vector<std::size_t> switch_of(n, npos);
+    std::vector<std::vector<Range>> ranges(n);
+    std::vector<bool> never(n, false);
+    std::vector<bool> is_switch(n, false);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const auto& sig = signals[i];
+        if (sig.SignalMultiplexerValues_Size() != 0)
+        {
+            // a signal is conditioned on exactly one switch, further entries for the same switch add value ranges
+            for (const auto& smv : sig.SignalMultiplexerValues())
+            {
+                auto iter = std::find_if(signals.begin(), signals.end(),
+                    [&](const SignalImpl& other) { return other.Name() == smv.SwitchName(); });
+                std::size_t j = iter == signals.end() ? npos : std::size_t(iter - signals.begin());
+                if (switch_of[i] == npos && !never[i])
+                {
+                    switch_of[i] = j;
+                    never[i] = j == npos;
+                }
+                if (j == npos || j != switch_of[i])
+                {
+                    continue;
+                }
+                for (const auto& r : smv.ValueRanges())
+                {
+                    if (r.from <= r.to)
+                    {
+                        ranges[i].push_back(Range{r.from, r.to});
+                    }
+                }
+            }
+        }
+        else if (sig.MultiplexerIndicator() == ISignal::EMultiplexer::MuxValue)
+        {
+            if (mux_index != npos && mux_index != i)
+            {
+                switch_of[i] = mux_index;
+                ranges[i].push_back(Range{sig.MultiplexerSwitchValue(), sig.MultiplexerSwitchValue()});
+            }
+            else
+            {
+                never[i] = true;
+            }
+        }
+        if (switch_of[i] != npos)
+        {
+            is_switch[switch_of[i]] = true;
+        }
+    }
+
+    // order the switches so every switch comes after the switch it depends on, cycles are never active
+    std::vector<uint8_t> visited(n, 0);
+    std::vector<uint32_t> slot_of(n, 0);
+    std::function<void(std::size_t)> visit = [&](std::size_t i)
+    {
+        if (visited[i] != 0)
+        {
+            return;
+        }
+        visited[i] = 1;
+        std::size_t parent = switch_of[i];
+        if (parent != npos)
+        {
+            if (visited[parent] == 1)
+            {
+                switch_of[i] = npos;
+                never[i] = true;
+            }
+            else
+            {
+                visit(parent);
+            }
+        }
+        visited[i] = 2;
+        if (is_switch[i])
+        {
+            slot_of[i] = uint32_t(_switches.size());
+            _switches.push_back(uint32_t(i));
+        }
+    };
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (is_switch[i])
+        {
+            visit(i);
+        }
+    }
+    if (_switches.size() > max_switches)
+    {
+        _switches.clear();
+        return false;
+    }
+
+    _conditions.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        Condition cond{Condition::EKind::Always, 0, 0, 0, 0};
+        if (never[i])
+        {
+            cond.kind = Condition::EKind::Never;
+        }
+        else if (switch_of[i] != npos)
+        {
+            cond.slot = slot_of[switch_of[i]];
+            auto& rs = ranges[i];
+            std::sort(rs.begin(), rs.end(), [](const Range& lhs, const Range& rhs) { return lhs.from < rhs.from; });
+            std::vector<Range> merged;
+            for (const auto& r : rs)
+            {
+                if (!merged.empty() && (merged.back().to == ~0ull || r.from <= merged.back().to + 1))
+                {
+                    merged.back().to = std::max(merged.back().to, r.to);
+                }
+                else
+                {
+                    merged.push_back(r);
+                }
+            }
+            if (merged.empty())
+            {
+                cond.kind = Condition::EKind::Never;
+            }
+            else if (merged.back().to < 64)
+            {
+                cond.kind = Condition::EKind::Bits;
+                for (const auto& r : merged)
+                {
+                    for (uint64_t v = r.from; v <= r.to; v++)
+                    {
+                        cond.bits |= 1ull << v;
+                    }
+                }
+            }
+            else
+            {
+                cond.kind = Condition::EKind::Ranges;
+                cond.ranges_begin = uint32_t(_ranges.size());
+                _ranges.insert(_ranges.end(), merged.begin(), merged.end());
+                cond.ranges_end = uint32_t(_ranges.size());
+            }
+        }
+        _conditions.push_back(cond);
+    }
+    return true;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "signal_impl.h"
+#include "decode_plan.h"
+
+namespace dbcppp
+{
+    // Compiled extended multiplexing (SG_MUL_VAL_) of one message.
+    // Every signal gets a condition "switch slot is active and its raw value lies in a value set".
+    // Switch names are resolved to signal positions at load time, value ranges are turned into a
+    // 64 bit set when they only cover values below 64 and into sorted, merged ranges otherwise.
+    // Switches are evaluated in dependency order so cascaded multiplexors (m2M) and independent
+    // multiplexors (several M signals) are resolved with one decode per switch and frame.
+    class MuxTree
+    {
+    public:
+        // messages with more switches than this are not compiled and keep the simple multiplexing
+        static constexpr std::size_t max_switches = 32;
+
+        struct State
+        {
+            bool active[max_switches];
+            uint64_t value[max_switches];
+        };
+
+        // mux_index is the position of the message's MuxSignal() or MuxDispatch::npos,
+        // it is used for MuxValue signals without SG_MUL_VAL_ entry
+        // returns false if the message doesn't use extended multiplexing
+        bool Build(const ArenaVector<SignalImpl>& signals, std::size_t mux_index);
+
+        bool Empty() const noexcept
+        {
+            return _conditions.empty();
+        }
+        inline void Evaluate(const DecodePlan& plan, const DecodePlan::Frame& frame, State& state) const noexcept
+        {
+            for (std::size_t i = 0; i < _switches.size(); i++)
+            {
+                state.active[i] = Holds(_conditions[_switches[i]], state);
+                state.value[i] = plan.Raw(frame, _switches[i]);
+            }
+        }
+        inline bool Active(const State& state, std::size_t signal_index) const noexcept
+        {
+            return Holds(_conditions[signal_index], state);
+        }
+
+    private:
+        struct Range
+        {
+            uint64_t from;
+            uint64_t to;
+        };
+        struct Condition
+        {
+            enum class EKind
+                : uint8_t
+            {
+                Always,
+                Never,
+                Bits,
+                Ranges
+            };
+
+            EKind kind;
+            uint32_t slot;
+            uint32_t ranges_begin;
+            uint32_t ranges_end;
+            uint64_t bits;
+        };
+
+        inline bool Holds(const Condition& cond, const State& state) const noexcept
+        {
+            switch (cond.kind)
+            {
+            case Condition::EKind::Always: return true;
+            case Condition::EKind::Never: return false;
+            default: break;
+            }
+            if (!state.active[cond.slot])
+            {
+                return false;
+            }
+            uint64_t value = state.value[cond.slot];
+            if (cond.kind == Condition::EKind::Bits)
+            {
+                return value < 64 && ((cond.bits >> value) & 1);
+            }
+            // ranges are sorted and disjoint, find the first one ending at or after value
+            uint32_t lo = cond.ranges_begin;
+            uint32_t hi = cond.ranges_end;
+            while (lo < hi)
+            {
+                uint32_t mid = (lo + hi) / 2;
+                if (_ranges[mid].to < value)
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            return lo < cond.ranges_end && _ranges[lo].from <= value;
+        }
+
+        // one condition per signal
+        ArenaVector<Condition> _conditions;
+        // signal positions of the switches in evaluation order, slot i is _switches[i]
+        ArenaVector<uint32_t> _switches;
+        ArenaVector<Range> _ranges;
+    };
+}
@@ -0,0 +1,73 @@
+#include <functional>
+#include "name_index.h"
+
+using namespace dbcppp;
+
+std::size_t NameIndex::Hash(std::string_view name) noexcept
+{
+    return std::hash<std::string_view>()(name);
+}
+void NameIndex::Build(const std::vector<std::string_view>& names)
+{
+    _slots.clear();
+    _order.clear();
+    _names.clear();
+    _slot_mask = 0;
+    if (names.empty())
+    {
+        return;
+    }
+
+    // keep the load factor at or below 50% like MessageIndex
+    std::size_t n_slots = 2;
+    while (n_slots < names.size() * 2)
+    {
+        n_slots *= 2;
+    }
+    _slots.resize(n_slots, Slot{0, 0, 0, {0, 0}});
+    _slot_mask = n_slots - 1;
+
+    // count the positions of every distinct name, remembering the slot of each position
+    std::vector<std::size_t> slot_of(names.size());
+    std::vector<std::size_t> groups;
+    for (std::size_t i = 0; i < names.size(); i++)
+    {
+        std::string_view name = names[i];
+        std::size_t hash = Hash(name);
+        for (std::size_t s = hash & _slot_mask;; s = (s + 1) & _slot_mask)
+        {
+            Slot& slot = _slots[s];
+            if (slot.range.count == 0)
+            {
+                slot.hash = hash;
+                slot.name_offset = uint32_t(_names.size());
+                slot.name_size = uint32_t(name.size());
+                slot.range.count = 1;
+                _names.insert(_names.end(), name.begin(), name.end());
+                groups.push_back(s);
+                slot_of[i] = s;
+                break;
+            }
+            if (slot.hash == hash && Name(slot) == name)
+            {
+                slot.range.count++;
+                slot_of[i] = s;
+                break;
+            }
+        }
+    }
+    // groups are laid out in the order their names first appear
+    uint32_t first = 0;
+    for (std::size_t s : groups)
+    {
+        _slots[s].range.first = first;
+        first += _slots[s].range.count;
+    }
+    std::vector<uint32_t> fill(n_slots, 0);
+    _order.resize(names.size());
+    for (std::size_t i = 0; i < names.size(); i++)
+    {
+        std::size_t s = slot_of[i];
+        _order[_slots[s].range.first + fill[s]++] = uint32_t(i);
+    }
+}
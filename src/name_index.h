@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+#include "arena.h"
+
+namespace dbcppp
+{
+    // Immutable name -> positions index, built once at load time. Positions with equal names
+    // form a group, Find() returns the group as a range of Order(), in which the positions of
+    // a group are adjacent and ascending. Linear probing hash table over a copy of the distinct
+    // names, so the index doesn't refer to the objects it was built from.
+    class NameIndex
+    {
+    public:
+        static constexpr uint32_t npos = 0xFFFFFFFF;
+
+        struct Range
+        {
+            uint32_t first;
+            uint32_t count;
+        };
+
+        // names[i] is the name of position i
+        void Build(const std::vector<std::string_view>& names);
+
+        inline Range Find(std::string_view name) const noexcept
+        {
+            if (_slots.empty())
+            {
+                return {0, 0};
+            }
+            std::size_t hash = Hash(name);
+            for (std::size_t i = hash & _slot_mask;; i = (i + 1) & _slot_mask)
+            {
+                const Slot& slot = _slots[i];
+                if (slot.range.count == 0)
+                {
+                    return {0, 0};
+                }
+                if (slot.hash == hash && Name(slot) == name)
+                {
+                    return slot.range;
+                }
+            }
+        }
+        // first position named name or npos
+        inline uint32_t FindFirst(std::string_view name) const noexcept
+        {
+            Range range = Find(name);
+            return range.count ? _order[range.first] : npos;
+        }
+        const ArenaVector<uint32_t>& Order() const noexcept
+        {
+            return _order;
+        }
+
+    private:
+        struct Slot
+        {
+            std::size_t hash;
+            uint32_t name_offset;
+            uint32_t name_size;
+            Range range;
+        };
+
+        static std::size_t Hash(std::string_view name) noexcept;
+        inline std::string_view Name(const Slot& slot) const noexcept
+        {
+            return {_names.data() + slot.name_offset, slot.name_size};
+        }
+
+        ArenaVector<Slot> _slots;
+        ArenaVector<uint32_t> _order;
+        ArenaVector<char> _names;
+        std::size_t _slot_mask = 0;
+    };
+}
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cstring>
+#include <functional>
 #include "dbcppp-tiny/network.h"
 #include "network_impl.h"
 #include "log.h"
@@ -19,12 +20,18 @@ std::unique_ptr<INetwork> INetwork::Create(
 {
     BitTimingImpl bt = std::move(static_cast<BitTimingImpl&>(*bit_timing));
     bit_timing.reset(nullptr);
-    std::vector<NodeImpl> ns;
-    std::vector<ValueTableImpl> vts;
-    std::vector<MessageImpl> ms;
-    std::vector<AttributeDefinitionImpl> ads;
-    std::vector<AttributeImpl> avds;
-    std::vector<AttributeImpl> avs;
+    ArenaVector<NodeImpl> ns;
+    ArenaVector<ValueTableImpl> vts;
+    ArenaVector<MessageImpl> ms;
+    ArenaVector<AttributeDefinitionImpl> ads;
+    ArenaVector<AttributeImpl> avds;
+    ArenaVector<AttributeImpl> avs;
+    ns.reserve(nodes.size());
+    vts.reserve(value_tables.size());
+    ms.reserve(messages.size());
+    ads.reserve(attribute_definitions.size());
+    avds.reserve(attribute_defaults.size());
+    avs.reserve(attribute_values.size());
     for (auto& n : nodes)
     {
         ns.push_back(std::move(static_cast<NodeImpl&>(*n)));
@@ -71,15 +78,15 @@ NetworkImpl::NetworkImpl(
       std::string&& version
     , std::vector<std::string>&& new_symbols
     , BitTimingImpl&& bit_timing
-    , std::vector<NodeImpl>&& nodes
-    , std::vector<ValueTableImpl>&& value_tables
-    , std::vector<MessageImpl>&& messages
-    , std::vector<AttributeDefinitionImpl>&& attribute_definitions
-    , std::vector<AttributeImpl>&& attribute_defaults
-    , std::vector<AttributeImpl>&& attribute_values)
+    , ArenaVector<NodeImpl>&& nodes
+    , ArenaVector<ValueTableImpl>&& value_tables
+    , ArenaVector<MessageImpl>&& messages
+    , ArenaVector<AttributeDefinitionImpl>&& attribute_definitions
+    , ArenaVector<AttributeImpl>&& attribute_defaults
+    , ArenaVector<AttributeImpl>&& attribute_values)
 
     : _version(std::move(version))
-    , _new_symbols(std::move(new_symbols))
+    , _new_symbols(std::make_move_iterator(new_symbols.begin()), std::make_move_iterator(new_symbols.end()))
     , _bit_timing(std::move(bit_timing))
     , _nodes(std::move(nodes))
     , _value_tables(std::move(value_tables))
@@ -87,7 +94,20 @@ NetworkImpl::NetworkImpl(
     , _attribute_definitions(std::move(attribute_definitions))
     , _attribute_defaults(std::move(attribute_defaults))
     , _attribute_values(std::move(attribute_values))
-{}
+{
+    std::vector<uint64_t> ids;
+    ids.reserve(_messages.size());
+    for (const auto& msg : _messages)
+    {
+        ids.push_back(msg.Id());
+    }
+    _message_index.Build(ids);
+    BuildNameIndices();
+    _attributes.Build(*this);
+#ifdef DBCPPP_JIT
+    CompileDecoders();
+#endif
+}
 const std::string& NetworkImpl::Version() const
 {
     return _version;
@@ -100,6 +120,10 @@ uint64_t NetworkImpl::NewSymbols_Size() const
 {
     return _new_symbols.size();
 }
+ObjectSpan<std::string> NetworkImpl::NewSymbols() const
+{
+    return {_new_symbols.data(), _new_symbols.size()};
+}
 const IBitTiming& NetworkImpl::BitTiming() const
 {
     return _bit_timing;
@@ -112,6 +136,10 @@ uint64_t NetworkImpl::Nodes_Size() const
 {
     return _nodes.size();
 }
+ObjectSpan<INode> NetworkImpl::Nodes() const
+{
+    return {_nodes.data(), _nodes.size()};
+}
 const IValueTable& NetworkImpl::ValueTables_Get(std::size_t i) const
 {
     return _value_tables[i];
@@ -120,6 +148,10 @@ uint64_t NetworkImpl::ValueTables_Size() const
 {
     return _value_tables.size();
 }
+ObjectSpan<IValueTable> NetworkImpl::ValueTables() const
+{
+    return {_value_tables.data(), _value_tables.size()};
+}
 const IMessage& NetworkImpl::Messages_Get(std::size_t i) const
 {
     return _messages[i];
@@ -128,6 +160,10 @@ uint64_t NetworkImpl::Messages_Size() const
 {
     return _messages.size();
 }
+ObjectSpan<IMessage> NetworkImpl::Messages() const
+{
+    return {_messages.data(), _messages.size()};
+}
 const IAttributeDefinition& NetworkImpl::AttributeDefinitions_Get(std::size_t i) const
 {
     return _attribute_definitions[i];
@@ -136,6 +172,10 @@ uint64_t NetworkImpl::AttributeDefinitions_Size() const
 {
     return _attribute_definitions.size();
 }
+ObjectSpan<IAttributeDefinition> NetworkImpl::AttributeDefinitions() const
+{
+    return {_attribute_definitions.data(), _attribute_definitions.size()};
+}
 const IAttribute& NetworkImpl::AttributeDefaults_Get(std::size_t i) const
 {
     return _attribute_defaults[i];
@@ -144,6 +184,10 @@ uint64_t NetworkImpl::AttributeDefaults_Size() const
 {
     return _attribute_defaults.size();
 }
+ObjectSpan<IAttribute> NetworkImpl::AttributeDefaults() const
+{
+    return {_attribute_defaults.data(), _attribute_defaults.size()};
+}
 const IAttribute& NetworkImpl::AttributeValues_Get(std::size_t i) const
 {
     return _attribute_values[i];
@@ -152,26 +196,131 @@ uint64_t NetworkImpl::AttributeValues_Size() const
 {
     return _attribute_values.size();
 }
+ObjectSpan<IAttribute> NetworkImpl::AttributeValues() const
+{
+    return {_attribute_values.data(), _attribute_values.size()};
+}
 const IMessage* NetworkImpl::ParentMessage(const ISignal* sig) const
 {
-    const IMessage* parent = nullptr;
+    if (sig == nullptr)
+    {
+        return nullptr;
+    }
+    // the signal's back-reference, if it points into this network's messages
+    auto parent = static_cast<const MessageImpl*>(static_cast<const SignalImpl*>(sig)->Message());
+    std::less<const MessageImpl*> less;
+    if (parent == nullptr || less(parent, _messages.data()) || !less(parent, _messages.data() + _messages.size()))
+    {
+        return nullptr;
+    }
+    return parent;
+}
+const IMessage* NetworkImpl::FindMessage(uint64_t id) const
+{
+    uint32_t i = _message_index.Find(id);
+    return i == MessageIndex::npos ? nullptr : &_messages[i];
+}
+const IMessage* NetworkImpl::FindMessageByName(std::string_view name) const
+{
+    uint32_t i = _message_names.FindFirst(name);
+    return i == NameIndex::npos ? nullptr : &_messages[i];
+}
+const INode* NetworkImpl::FindNode(std::string_view name) const
+{
+    uint32_t i = _node_names.FindFirst(name);
+    return i == NameIndex::npos ? nullptr : &_nodes[i];
+}
+ObjectSpan<MessageSignal> NetworkImpl::FindSignal(std::string_view name) const
+{
+    NameIndex::Range range = _signal_names.Find(name);
+    return {_signals_by_name.data() + range.first, range.count};
+}
+std::size_t NetworkImpl::AttributeId(std::string_view name) const
+{
+    return _attributes.Find(name);
+}
+const IAttribute* NetworkImpl::GetAttribute(const INetwork& net, std::size_t attr_id) const
+{
+    return &net == this ? _attributes.Get(IAttributeDefinition::EObjectType::Network, 0, attr_id) : nullptr;
+}
+const IAttribute* NetworkImpl::GetAttribute(const INode& node, std::size_t attr_id) const
+{
+    auto impl = static_cast<const NodeImpl*>(&node);
+    std::less<const NodeImpl*> less;
+    if (less(impl, _nodes.data()) || !less(impl, _nodes.data() + _nodes.size()))
+    {
+        return nullptr;
+    }
+    return _attributes.Get(IAttributeDefinition::EObjectType::Node, impl - _nodes.data(), attr_id);
+}
+const IAttribute* NetworkImpl::GetAttribute(const IMessage& msg, std::size_t attr_id) const
+{
+    auto impl = static_cast<const MessageImpl*>(&msg);
+    std::less<const MessageImpl*> less;
+    if (less(impl, _messages.data()) || !less(impl, _messages.data() + _messages.size()))
+    {
+        return nullptr;
+    }
+    return _attributes.Get(IAttributeDefinition::EObjectType::Message, impl - _messages.data(), attr_id);
+}
+const IAttribute* NetworkImpl::GetAttribute(const ISignal& sig, std::size_t attr_id) const
+{
+    auto parent = static_cast<const MessageImpl*>(ParentMessage(&sig));
+    if (parent == nullptr)
+    {
+        return nullptr;
+    }
+    // a copy of a signal keeps the back-reference to its message but isn't one of its signals
+    auto impl = static_cast<const SignalImpl*>(&sig);
+    const auto& signals = parent->signals();
+    std::less<const SignalImpl*> less;
+    if (less(impl, signals.data()) || !less(impl, signals.data() + signals.size()))
+    {
+        return nullptr;
+    }
+    std::size_t row = _attributes.FirstSignalRow(parent - _messages.data()) + (impl - signals.data());
+    return _attributes.Get(IAttributeDefinition::EObjectType::Signal, row, attr_id);
+}
+void NetworkImpl::BuildNameIndices()
+{
+    std::vector<std::string_view> names;
+    names.reserve(_messages.size());
+    for (const auto& msg : _messages)
+    {
+        names.push_back(msg.Name());
+    }
+    _message_names.Build(names);
+
+    names.clear();
+    for (const auto& node : _nodes)
+    {
+        names.push_back(node.Name());
+    }
+    _node_names.Build(names);
+
+    names.clear();
+    std::vector<MessageSignal> signals;
     for (const auto& msg : _messages)
     {
-        auto iter = std::find_if(msg.signals().begin(), msg.signals().end(),
-            [&](const SignalImpl& other) { return &other == sig; });
-        if (iter != msg.signals().end())
+        for (const auto& sig : msg.signals())
         {
-            parent = &msg;
-            break;
+            names.push_back(sig.Name());
+            signals.push_back({&msg, &sig});
         }
     }
-    return parent;
+    _signal_names.Build(names);
+    _signals_by_name.clear();
+    _signals_by_name.reserve(signals.size());
+    for (uint32_t i : _signal_names.Order())
+    {
+        _signals_by_name.push_back(signals[i]);
+    }
 }
 std::string& NetworkImpl::version()
 {
     return _version;
 }
-std::vector<std::string>& NetworkImpl::newSymbols()
+ArenaVector<std::string>& NetworkImpl::newSymbols()
 {
     return _new_symbols;
 }
@@ -179,30 +328,68 @@ BitTimingImpl& NetworkImpl::bitTiming()
 {
     return _bit_timing;
 }
-std::vector<NodeImpl>& NetworkImpl::nodes()
+ArenaVector<NodeImpl>& NetworkImpl::nodes()
 {
     return _nodes;
 }
-std::vector<ValueTableImpl>& NetworkImpl::valueTables()
+ArenaVector<ValueTableImpl>& NetworkImpl::valueTables()
 {
     return _value_tables;
 }
-std::vector<MessageImpl>& NetworkImpl::messages()
+ArenaVector<MessageImpl>& NetworkImpl::messages()
 {
     return _messages;
 }
-std::vector<AttributeDefinitionImpl>& NetworkImpl::attributeDefinitions()
+ArenaVector<AttributeDefinitionImpl>& NetworkImpl::attributeDefinitions()
 {
     return _attribute_definitions;
 }
-std::vector<AttributeImpl>& NetworkImpl::attributeDefaults()
+ArenaVector<AttributeImpl>& NetworkImpl::attributeDefaults()
 {
     return _attribute_defaults;
 }
-std::vector<AttributeImpl>& NetworkImpl::attributeValues()
+ArenaVector<AttributeImpl>& NetworkImpl::attributeValues()
 {
     return _attribute_values;
 }
+void NetworkImpl::AdoptArena(std::unique_ptr<Arena>&& arena)
+{
+    _arena = std::move(arena);
+}
+const Arena* NetworkImpl::GetArena() const
+{
+    return _arena.get();
+}
+void NetworkImpl::AdoptStrings(std::unique_ptr<StringPool>&& strings)
+{
+    strings->Freeze();
+    _strings = std::move(strings);
+}
+const StringPool* NetworkImpl::GetStrings() const
+{
+    return _strings.get();
+}
+bool NetworkImpl::CompileDecoders()
+{
+    std::vector<const DecodePlan*> plans;
+    plans.reserve(_messages.size());
+    for (const auto& msg : _messages)
+    {
+        plans.push_back(&msg.decodePlan());
+    }
+    auto jit = std::make_unique<DecodeJit>();
+    if (!jit->Compile(plans))
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < _messages.size(); i++)
+    {
+        _messages[i].decodePlan().SetNative(jit->Entry(i));
+    }
+    // the old code is unmapped only after no plan refers to it anymore
+    _jit = std::move(jit);
+    return true;
+}
 
 std::map<std::string, std::unique_ptr<INetwork>> INetwork::LoadNetworkFromFile(const std::string& filename)
 {
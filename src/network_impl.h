@@ -7,6 +7,12 @@
 #include "signal_type_impl.h"
 #include "attribute_definition_impl.h"
 #include "attribute_impl.h"
+#include "message_index.h"
+#include "name_index.h"
+#include "attribute_index.h"
+#include "decode_jit.h"
+#include "arena.h"
+#include "string_pool.h"
 
 namespace dbcppp
 {
@@ -18,53 +24,94 @@ namespace dbcppp
               std::string&& version
             , std::vector<std::string>&& new_symbols
             , BitTimingImpl&& bit_timing
-            , std::vector<NodeImpl>&& nodes
-            , std::vector<ValueTableImpl>&& value_tables
-            , std::vector<MessageImpl>&& messages
-            , std::vector<AttributeDefinitionImpl>&& attribute_definitions
-            , std::vector<AttributeImpl>&& attribute_defaults
-            , std::vector<AttributeImpl>&& attribute_values);
+            , ArenaVector<NodeImpl>&& nodes
+            , ArenaVector<ValueTableImpl>&& value_tables
+            , ArenaVector<MessageImpl>&& messages
+            , ArenaVector<AttributeDefinitionImpl>&& attribute_definitions
+            , ArenaVector<AttributeImpl>&& attribute_defaults
+            , ArenaVector<AttributeImpl>&& attribute_values);
             
         
         virtual const std::string& Version() const override;
         virtual const std::string& NewSymbols_Get(std::size_t i) const override;
         virtual uint64_t NewSymbols_Size() const override;
+        virtual ObjectSpan<std::string> NewSymbols() const override;
         virtual const IBitTiming& BitTiming() const override;
         virtual const INode& Nodes_Get(std::size_t i) const override;
         virtual uint64_t Nodes_Size() const override;
+        virtual ObjectSpan<INode> Nodes() const override;
         virtual const IValueTable& ValueTables_Get(std::size_t i) const override;
         virtual uint64_t ValueTables_Size() const override;
+        virtual ObjectSpan<IValueTable> ValueTables() const override;
         virtual const IMessage& Messages_Get(std::size_t i) const override;
         virtual uint64_t Messages_Size() const override;
+        virtual ObjectSpan<IMessage> Messages() const override;
         virtual const IAttributeDefinition& AttributeDefinitions_Get(std::size_t i) const override;
         virtual uint64_t AttributeDefinitions_Size() const override;
+        virtual ObjectSpan<IAttributeDefinition> AttributeDefinitions() const override;
         virtual const IAttribute& AttributeDefaults_Get(std::size_t i) const override;
         virtual uint64_t AttributeDefaults_Size() const override;
+        virtual ObjectSpan<IAttribute> AttributeDefaults() const override;
         virtual const IAttribute& AttributeValues_Get(std::size_t i) const override;
         virtual uint64_t AttributeValues_Size() const override;
+        virtual ObjectSpan<IAttribute> AttributeValues() const override;
         
         virtual const IMessage* ParentMessage(const ISignal* sig) const override;
+        virtual const IMessage* FindMessage(uint64_t id) const override;
+        virtual const IMessage* FindMessageByName(std::string_view name) const override;
+        virtual const INode* FindNode(std::string_view name) const override;
+        virtual ObjectSpan<MessageSignal> FindSignal(std::string_view name) const override;
+        virtual std::size_t AttributeId(std::string_view name) const override;
+        virtual const IAttribute* GetAttribute(const INetwork& net, std::size_t attr_id) const override;
+        virtual const IAttribute* GetAttribute(const INode& node, std::size_t attr_id) const override;
+        virtual const IAttribute* GetAttribute(const IMessage& msg, std::size_t attr_id) const override;
+        virtual const IAttribute* GetAttribute(const ISignal& sig, std::size_t attr_id) const override;
         
 
         std::string& version();
-        std::vector<std::string>& newSymbols();
+        ArenaVector<std::string>& newSymbols();
         BitTimingImpl& bitTiming();
-        std::vector<NodeImpl>& nodes();
-        std::vector<ValueTableImpl>& valueTables();
-        std::vector<MessageImpl>& messages();
-        std::vector<AttributeDefinitionImpl>& attributeDefinitions();
-        std::vector<AttributeImpl>& attributeDefaults();
-        std::vector<AttributeImpl>& attributeValues();
+        ArenaVector<NodeImpl>& nodes();
+        ArenaVector<ValueTableImpl>& valueTables();
+        ArenaVector<MessageImpl>& messages();
+        ArenaVector<AttributeDefinitionImpl>& attributeDefinitions();
+        ArenaVector<AttributeImpl>& attributeDefaults();
+        ArenaVector<AttributeImpl>& attributeValues();
+
+        // Takes ownership of the arena the network was built in (see INetwork::LoadOptions)
+        void AdoptArena(std::unique_ptr<Arena>&& arena);
+        const Arena* GetArena() const;
+        // Takes ownership of the pool the strings of the network were interned into
+        void AdoptStrings(std::unique_ptr<StringPool>&& strings);
+        const StringPool* GetStrings() const;
+        // Compiles the DecodeAll of every message to native code (see DecodeJit), done when the
+        // network is built with DBCPPP_JIT. Returns false if there's no JIT for this platform.
+        bool CompileDecoders();
 
     private:
+        void BuildNameIndices();
+
+        // declared first so they are destroyed after every object referring to them
+        std::unique_ptr<Arena> _arena;
+        std::unique_ptr<StringPool> _strings;
+
         std::string _version;
-        std::vector<std::string> _new_symbols;
+        ArenaVector<std::string> _new_symbols;
         BitTimingImpl _bit_timing;
-        std::vector<NodeImpl> _nodes;
-        std::vector<ValueTableImpl> _value_tables;
-        std::vector<MessageImpl> _messages;
-        std::vector<AttributeDefinitionImpl> _attribute_definitions;
-        std::vector<AttributeImpl> _attribute_defaults;
-        std::vector<AttributeImpl> _attribute_values;
+        ArenaVector<NodeImpl> _nodes;
+        ArenaVector<ValueTableImpl> _value_tables;
+        ArenaVector<MessageImpl> _messages;
+        ArenaVector<AttributeDefinitionImpl> _attribute_definitions;
+        ArenaVector<AttributeImpl> _attribute_defaults;
+        ArenaVector<AttributeImpl> _attribute_values;
+
+        MessageIndex _message_index;
+        NameIndex _message_names;
+        NameIndex _node_names;
+        NameIndex _signal_names;
+        // every signal of the network in the order of _signal_names.Order()
+        ArenaVector<MessageSignal> _signals_by_name;
+        AttributeIndex _attributes;
+        std::unique_ptr<DecodeJit> _jit;
     };
 }
\ No newline at end of file
@@ -0,0 +1,790 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "network_snapshot.h"
+#include "message_impl.h"
+#include "network_impl.h"
+#include "string_pool.h"
+#include "mapped_file.h"
+#include "log.h"
+
+#ifdef _WIN32
+#   include <process.h>
+#else
+#   include <unistd.h>
+#endif
+
+using namespace dbcppp;
+using namespace dbcppp::snapshot;
+
+namespace
+{
+    // record size of every table, a snapshot written with a different layout is rejected
+    constexpr uint32_t record_sizes[TableCount] =
+    {
+          1
+        , sizeof(Str)
+        , sizeof(Attribute)
+        , sizeof(AttributeDefinition)
+        , sizeof(Node)
+        , sizeof(ValueDescription)
+        , sizeof(SignalType)
+        , sizeof(ValueTable)
+        , sizeof(MuxRange)
+        , sizeof(MuxValue)
+        , sizeof(Signal)
+        , sizeof(SignalGroup)
+        , sizeof(Message)
+        , sizeof(MessageId)
+    };
+
+    class SnapshotWriter
+    {
+    public:
+        Str Intern(const std::string& str)
+        {
+            auto iter = _interned.find(str);
+            if (iter != _interned.end())
+            {
+                return iter->second;
+            }
+            Str result{uint32_t(_pool.size()), uint32_t(str.size())};
+            _pool.insert(_pool.end(), str.begin(), str.end());
+            _interned.emplace(str, result);
+            return result;
+        }
+        template <class Iterable>
+        Span AddStrings(Iterable&& strs)
+        {
+            Span span{uint32_t(_strings.size()), 0};
+            for (const auto& str : strs)
+            {
+                _strings.push_back(Intern(str));
+                span.count++;
+            }
+            return span;
+        }
+        Attribute MakeAttribute(const IAttribute& attr)
+        {
+            Attribute rec{};
+            rec.name = Intern(attr.Name());
+            rec.object_type = uint8_t(attr.ObjectType());
+            const auto& value = attr.Value();
+            if (auto i = std::get_if<int64_t>(&value))
+            {
+                rec.kind = AttributeKind::Int;
+                rec.int_value = *i;
+            }
+            else if (auto d = std::get_if<double>(&value))
+            {
+                rec.kind = AttributeKind::Double;
+                rec.double_value = *d;
+            }
+            else
+            {
+                rec.kind = AttributeKind::String;
+                rec.string_value = Intern(std::get<std::string>(value));
+            }
+            return rec;
+        }
+        template <class Iterable>
+        Span AddAttributes(Iterable&& attrs)
+        {
+            Span span{uint32_t(_attributes.size()), 0};
+            for (const auto& attr : attrs)
+            {
+                _attributes.push_back(MakeAttribute(attr));
+                span.count++;
+            }
+            return span;
+        }
+        template <class Iterable>
+        Span AddValueDescriptions(Iterable&& descs)
+        {
+            Span span{uint32_t(_value_descriptions.size()), 0};
+            for (const auto& desc : descs)
+            {
+                _value_descriptions.push_back(ValueDescription{desc.Value(), Intern(desc.Description())});
+                span.count++;
+            }
+            return span;
+        }
+
+        void AddNetwork(const INetwork& net)
+        {
+            _header.baudrate = net.BitTiming().Baudrate();
+            _header.btr1 = net.BitTiming().BTR1();
+            _header.btr2 = net.BitTiming().BTR2();
+            _header.version_string = Intern(net.Version());
+            _header.new_symbols = AddStrings(net.NewSymbols());
+            _header.attribute_defaults = AddAttributes(net.AttributeDefaults());
+            _header.attribute_values = AddAttributes(net.AttributeValues());
+            for (const auto& def : net.AttributeDefinitions())
+            {
+                AddAttributeDefinition(def);
+            }
+            for (const auto& node : net.Nodes())
+            {
+                Node rec{};
+                rec.name = Intern(node.Name());
+                rec.attributes = AddAttributes(node.AttributeValues());
+                _nodes.push_back(rec);
+            }
+            for (const auto& vt : net.ValueTables())
+            {
+                AddValueTable(vt);
+            }
+            for (const auto& msg : net.Messages())
+            {
+                AddMessage(static_cast<const MessageImpl&>(msg));
+            }
+            for (std::size_t i = 0; i < _messages.size(); i++)
+            {
+                _message_ids.push_back(MessageId{_messages[i].id, uint32_t(i), 0});
+            }
+            // stable so the first of several messages with the same id wins like in MessageIndex
+            std::stable_sort(_message_ids.begin(), _message_ids.end(),
+                [](const MessageId& lhs, const MessageId& rhs) { return lhs.id < rhs.id; });
+        }
+
+        void Finish(std::string& out)
+        {
+            std::memcpy(_header.magic, magic, sizeof(magic));
+            _header.version = version;
+            _header.byte_order = byte_order_mark;
+
+            std::size_t offset = sizeof(Header);
+            auto place = [&](Table table, std::size_t count)
+            {
+                offset = (offset + 7) & ~std::size_t(7);
+                _header.tables[table] = Section{offset, uint32_t(count), record_sizes[table]};
+                offset += count * record_sizes[table];
+            };
+            place(Strings, _strings.size());
+            place(Attributes, _attributes.size());
+            place(AttributeDefinitions, _attribute_definitions.size());
+            place(Nodes, _nodes.size());
+            place(ValueDescriptions, _value_descriptions.size());
+            place(SignalTypes, _signal_types.size());
+            place(ValueTables, _value_tables.size());
+            place(MuxRanges, _mux_ranges.size());
+            place(MuxValues, _mux_values.size());
+            place(Signals, _signals.size());
+            place(SignalGroups, _signal_groups.size());
+            place(Messages, _messages.size());
+            place(MessageIds, _message_ids.size());
+            place(Pool, _pool.size());
+            _header.file_size = offset;
+
+            out.assign(offset, '\0');
+            std::memcpy(&out[0], &_header, sizeof(_header));
+            auto copy = [&](Table table, const auto& records)
+            {
+                if (!records.empty())
+                {
+                    std::memcpy(&out[_header.tables[table].offset], records.data(), records.size() * record_sizes[table]);
+                }
+            };
+            copy(Strings, _strings);
+            copy(Attributes, _attributes);
+            copy(AttributeDefinitions, _attribute_definitions);
+            copy(Nodes, _nodes);
+            copy(ValueDescriptions, _value_descriptions);
+            copy(SignalTypes, _signal_types);
+            copy(ValueTables, _value_tables);
+            copy(MuxRanges, _mux_ranges);
+            copy(MuxValues, _mux_values);
+            copy(Signals, _signals);
+            copy(SignalGroups, _signal_groups);
+            copy(Messages, _messages);
+            copy(MessageIds, _message_ids);
+            copy(Pool, _pool);
+        }
+
+    private:
+        void AddAttributeDefinition(const IAttributeDefinition& def)
+        {
+            AttributeDefinition rec{};
+            rec.name = Intern(def.Name());
+            rec.object_type = uint8_t(def.ObjectType());
+            const auto& type = def.ValueType();
+            if (auto t = std::get_if<IAttributeDefinition::ValueTypeInt>(&type))
+            {
+                rec.kind = DefinitionKind::Int;
+                rec.int_minimum = t->minimum;
+                rec.int_maximum = t->maximum;
+            }
+            else if (auto t = std::get_if<IAttributeDefinition::ValueTypeHex>(&type))
+            {
+                rec.kind = DefinitionKind::Hex;
+                rec.int_minimum = t->minimum;
+                rec.int_maximum = t->maximum;
+            }
+            else if (auto t = std::get_if<IAttributeDefinition::ValueTypeFloat>(&type))
+            {
+                rec.kind = DefinitionKind::Float;
+                rec.float_minimum = t->minimum;
+                rec.float_maximum = t->maximum;
+            }
+            else if (std::holds_alternative<IAttributeDefinition::ValueTypeString>(type))
+            {
+                rec.kind = DefinitionKind::String;
+            }
+            else
+            {
+                rec.kind = DefinitionKind::Enum;
+                rec.enum_values = AddStrings(std::get<IAttributeDefinition::ValueTypeEnum>(type).values);
+            }
+            _attribute_definitions.push_back(rec);
+        }
+        void AddValueTable(const IValueTable& vt)
+        {
+            ValueTable rec{};
+            rec.name = Intern(vt.Name());
+            rec.descriptions = AddValueDescriptions(vt.ValueEncodingDescriptions());
+            rec.signal_type = npos;
+            if (auto st = vt.SignalType())
+            {
+                const ISignalType& type = st->get();
+                SignalType str{};
+                str.name = Intern(type.Name());
+                str.unit = Intern(type.Unit());
+                str.value_table = Intern(type.ValueTable());
+                str.size = type.SignalSize();
+                str.factor = type.Factor();
+                str.offset = type.Offset();
+                str.minimum = type.Minimum();
+                str.maximum = type.Maximum();
+                str.default_value = type.DefaultValue();
+                str.byte_order = uint8_t(type.ByteOrder());
+                str.value_type = uint8_t(type.ValueType());
+                rec.signal_type = uint32_t(_signal_types.size());
+                _signal_types.push_back(str);
+            }
+            _value_tables.push_back(rec);
+        }
+        Signal MakeSignal(const ISignal& sig, const DecodeStep& step)
+        {
+            Signal rec{};
+            rec.step = step;
+            rec.name = Intern(sig.Name());
+            rec.unit = Intern(sig.Unit());
+            rec.start_bit = sig.StartBit();
+            rec.bit_size = sig.BitSize();
+            rec.mux_switch_value = sig.MultiplexerSwitchValue();
+            rec.factor = sig.Factor();
+            rec.offset = sig.Offset();
+            rec.minimum = sig.Minimum();
+            rec.maximum = sig.Maximum();
+            rec.receivers = AddStrings(sig.Receivers());
+            rec.value_descriptions = AddValueDescriptions(sig.ValueEncodingDescriptions());
+            rec.attributes = AddAttributes(sig.AttributeValues());
+            rec.mux_values = Span{uint32_t(_mux_values.size()), 0};
+            for (const auto& smv : sig.SignalMultiplexerValues())
+            {
+                MuxValue mv{};
+                mv.switch_name = Intern(smv.SwitchName());
+                mv.ranges = Span{uint32_t(_mux_ranges.size()), 0};
+                for (const auto& range : smv.ValueRanges())
+                {
+                    _mux_ranges.push_back(MuxRange{range.from, range.to});
+                    mv.ranges.count++;
+                }
+                _mux_values.push_back(mv);
+                rec.mux_values.count++;
+            }
+            rec.multiplexer = uint8_t(sig.MultiplexerIndicator());
+            rec.byte_order = uint8_t(sig.ByteOrder());
+            rec.value_type = uint8_t(sig.ValueType());
+            rec.extended_value_type = uint8_t(sig.ExtendedValueType());
+            return rec;
+        }
+        void AddMessage(const MessageImpl& msg)
+        {
+            Message rec{};
+            rec.id = msg.Id();
+            rec.size = msg.MessageSize();
+            rec.name = Intern(msg.Name());
+            rec.transmitter = Intern(msg.Transmitter());
+            rec.transmitters = AddStrings(msg.MessageTransmitters());
+            // nested lists go to other tables, so each span stays contiguous
+            const DecodePlan& plan = msg.decodePlan();
+            rec.signals = Span{uint32_t(_signals.size()), uint32_t(msg.Signals_Size())};
+            for (std::size_t i = 0; i < msg.Signals_Size(); i++)
+            {
+                _signals.push_back(MakeSignal(msg.Signals_Get(i), plan[i]));
+            }
+            rec.attributes = AddAttributes(msg.AttributeValues());
+            rec.signal_groups = Span{uint32_t(_signal_groups.size()), uint32_t(msg.SignalGroups_Size())};
+            for (const auto& sg : msg.SignalGroups())
+            {
+                SignalGroup group{};
+                group.message_id = sg.MessageId();
+                group.repetitions = sg.Repetitions();
+                group.name = Intern(sg.Name());
+                group.signal_names = AddStrings(sg.SignalNames());
+                _signal_groups.push_back(group);
+            }
+            rec.extent = uint32_t(plan.Extent());
+            _messages.push_back(rec);
+        }
+
+        Header _header{};
+        std::vector<char> _pool;
+        std::unordered_map<std::string, Str> _interned;
+        std::vector<Str> _strings;
+        std::vector<Attribute> _attributes;
+        std::vector<AttributeDefinition> _attribute_definitions;
+        std::vector<Node> _nodes;
+        std::vector<ValueDescription> _value_descriptions;
+        std::vector<SignalType> _signal_types;
+        std::vector<ValueTable> _value_tables;
+        std::vector<MuxRange> _mux_ranges;
+        std::vector<MuxValue> _mux_values;
+        std::vector<Signal> _signals;
+        std::vector<SignalGroup> _signal_groups;
+        std::vector<Message> _messages;
+        std::vector<MessageId> _message_ids;
+    };
+}
+
+void dbcppp::WriteSnapshot(const INetwork& net, std::string& out)
+{
+    SnapshotWriter writer;
+    writer.AddNetwork(net);
+    writer.Finish(out);
+}
+
+bool NetworkSnapshot::Open(std::string_view data) noexcept
+{
+    _data = nullptr;
+    _size = 0;
+    _header = nullptr;
+    if (data.size() < sizeof(snapshot::Header) || reinterpret_cast<uintptr_t>(data.data()) % 8 != 0)
+    {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const snapshot::Header*>(data.data());
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 ||
+        header->version != version ||
+        header->byte_order != byte_order_mark ||
+        header->file_size != data.size())
+    {
+        return false;
+    }
+    for (uint32_t t = 0; t < TableCount; t++)
+    {
+        const Section& section = header->tables[t];
+        if (section.record_size != record_sizes[t] ||
+            (t != Pool && section.offset % 8 != 0) ||
+            section.offset < sizeof(snapshot::Header) ||
+            section.offset > data.size() ||
+            section.count > (data.size() - section.offset) / section.record_size)
+        {
+            return false;
+        }
+    }
+    _data = data.data();
+    _size = data.size();
+    _header = header;
+    if (!Validate())
+    {
+        _data = nullptr;
+        _size = 0;
+        _header = nullptr;
+        return false;
+    }
+    return true;
+}
+bool NetworkSnapshot::Validate() const noexcept
+{
+    auto str_ok = [&](Str str)
+    {
+        return str.offset <= Count(Pool) && str.size <= Count(Pool) - str.offset;
+    };
+    auto span_ok = [&](Span span, Table table)
+    {
+        return span.first <= Count(table) && span.count <= Count(table) - span.first;
+    };
+    auto attributes_ok = [&](Span span)
+    {
+        return span_ok(span, Attributes);
+    };
+
+    if (!str_ok(_header->version_string) ||
+        !span_ok(_header->new_symbols, Strings) ||
+        !attributes_ok(_header->attribute_defaults) ||
+        !attributes_ok(_header->attribute_values))
+    {
+        return false;
+    }
+    const Str* strings = Records<Str>(Strings);
+    for (std::size_t i = 0; i < Count(Strings); i++)
+    {
+        if (!str_ok(strings[i])) return false;
+    }
+    const Attribute* attributes = Records<Attribute>(Attributes);
+    for (std::size_t i = 0; i < Count(Attributes); i++)
+    {
+        const Attribute& attr = attributes[i];
+        if (!str_ok(attr.name) || !str_ok(attr.string_value) ||
+            attr.kind > AttributeKind::String ||
+            attr.object_type > uint8_t(IAttributeDefinition::EObjectType::Signal))
+        {
+            return false;
+        }
+    }
+    const AttributeDefinition* definitions = Records<AttributeDefinition>(AttributeDefinitions);
+    for (std::size_t i = 0; i < Count(AttributeDefinitions); i++)
+    {
+        const AttributeDefinition& def = definitions[i];
+        if (!str_ok(def.name) || !span_ok(def.enum_values, Strings) ||
+            def.kind > DefinitionKind::Enum ||
+            def.object_type > uint8_t(IAttributeDefinition::EObjectType::Signal))
+        {
+            return false;
+        }
+    }
+    const Node* nodes = Records<Node>(Nodes);
+    for (std::size_t i = 0; i < Count(Nodes); i++)
+    {
+        if (!str_ok(nodes[i].name) || !attributes_ok(nodes[i].attributes)) return false;
+    }
+    const ValueDescription* descriptions = Records<ValueDescription>(ValueDescriptions);
+    for (std::size_t i = 0; i < Count(ValueDescriptions); i++)
+    {
+        if (!str_ok(descriptions[i].description)) return false;
+    }
+    const SignalType* signal_types = Records<SignalType>(SignalTypes);
+    for (std::size_t i = 0; i < Count(SignalTypes); i++)
+    {
+        const SignalType& st = signal_types[i];
+        if (!str_ok(st.name) || !str_ok(st.unit) || !str_ok(st.value_table) ||
+            st.byte_order > 1 || st.value_type > 1)
+        {
+            return false;
+        }
+    }
+    const ValueTable* value_tables = Records<ValueTable>(ValueTables);
+    for (std::size_t i = 0; i < Count(ValueTables); i++)
+    {
+        const ValueTable& vt = value_tables[i];
+        if (!str_ok(vt.name) || !span_ok(vt.descriptions, ValueDescriptions) ||
+            (vt.signal_type != npos && vt.signal_type >= Count(SignalTypes)))
+        {
+            return false;
+        }
+    }
+    const MuxValue* mux_values = Records<MuxValue>(MuxValues);
+    for (std::size_t i = 0; i < Count(MuxValues); i++)
+    {
+        if (!str_ok(mux_values[i].switch_name) || !span_ok(mux_values[i].ranges, MuxRanges)) return false;
+    }
+    const Signal* signals = Records<Signal>(Signals);
+    for (std::size_t i = 0; i < Count(Signals); i++)
+    {
+        const Signal& sig = signals[i];
+        if (!str_ok(sig.name) || !str_ok(sig.unit) ||
+            !span_ok(sig.receivers, Strings) ||
+            !span_ok(sig.value_descriptions, ValueDescriptions) ||
+            !attributes_ok(sig.attributes) ||
+            !span_ok(sig.mux_values, MuxValues) ||
+            sig.multiplexer > uint8_t(ISignal::EMultiplexer::MuxValue) ||
+            sig.byte_order > 1 || sig.value_type > 1 ||
+            sig.extended_value_type > uint8_t(ISignal::EExtendedValueType::Double) ||
+            sig.step.kind > DecodeStep::EKind::SpanBigEndian ||
+            sig.step.value > DecodeStep::EValue::Double ||
+            sig.step.shift0 > 63 || sig.step.shift1 > 63 || sig.step.sign_shift > 63)
+        {
+            return false;
+        }
+    }
+    const SignalGroup* groups = Records<SignalGroup>(SignalGroups);
+    for (std::size_t i = 0; i < Count(SignalGroups); i++)
+    {
+        if (!str_ok(groups[i].name) || !span_ok(groups[i].signal_names, Strings)) return false;
+    }
+    const Message* messages = Records<Message>(Messages);
+    for (std::size_t i = 0; i < Count(Messages); i++)
+    {
+        const Message& msg = messages[i];
+        if (!str_ok(msg.name) || !str_ok(msg.transmitter) ||
+            !span_ok(msg.transmitters, Strings) ||
+            !span_ok(msg.signals, Signals) ||
+            !attributes_ok(msg.attributes) ||
+            !span_ok(msg.signal_groups, SignalGroups) ||
+            msg.extent < 8)
+        {
+            return false;
+        }
+        // DecodeAll relies on the steps staying within the extent
+        for (uint32_t j = 0; j < msg.signals.count; j++)
+        {
+            if (DecodePlan::StepExtent(signals[msg.signals.first + j].step) > msg.extent) return false;
+        }
+    }
+    const MessageId* ids = Records<MessageId>(MessageIds);
+    for (std::size_t i = 0; i < Count(MessageIds); i++)
+    {
+        if (ids[i].index >= Count(Messages) || (i != 0 && ids[i - 1].id > ids[i].id)) return false;
+    }
+    return true;
+}
+const snapshot::Message* NetworkSnapshot::FindMessage(uint64_t id) const noexcept
+{
+    const MessageId* first = Records<MessageId>(MessageIds);
+    const MessageId* last = first + Count(MessageIds);
+    const MessageId* iter = std::lower_bound(first, last, id,
+        [](const MessageId& entry, uint64_t id) { return entry.id < id; });
+    if (iter == last || iter->id != id)
+    {
+        return nullptr;
+    }
+    return Records<Message>(Messages) + iter->index;
+}
+std::size_t NetworkSnapshot::DecodeAll(const snapshot::Message& msg, const void* bytes, std::size_t len, double* out) const noexcept
+{
+    DecodePlan::Frame frame;
+    if (!DecodePlan::Prepare(bytes, len, msg.extent, frame))
+    {
+        return 0;
+    }
+    const Signal* sig = Records<Signal>(Signals) + msg.signals.first;
+    const Signal* end = sig + msg.signals.count;
+    for (; sig != end; ++sig, ++out)
+    {
+        *out = DecodePlan::RawToPhys(sig->step, DecodePlan::Extract(sig->step, frame.data, frame.first_le, frame.first_be));
+    }
+    return msg.signals.count;
+}
+
+std::unique_ptr<INetwork> NetworkSnapshot::Materialize() const
+{
+    // strings are interned into a pool owned by the network like in DBCAST2Network
+    auto strings = std::make_unique<StringPool>();
+    StringPoolScope scope(*strings);
+    auto str = [&](Str s)
+    {
+        return std::string(String(s));
+    };
+    auto strs = [&](Span span)
+    {
+        std::vector<std::string> result;
+        result.reserve(span.count);
+        const Str* strings = Records<Str>(Strings) + span.first;
+        for (uint32_t i = 0; i < span.count; i++)
+        {
+            result.push_back(str(strings[i]));
+        }
+        return result;
+    };
+    auto attributes = [&](Span span)
+    {
+        std::vector<std::unique_ptr<IAttribute>> result;
+        result.reserve(span.count);
+        const Attribute* attrs = Records<Attribute>(Attributes) + span.first;
+        for (uint32_t i = 0; i < span.count; i++)
+        {
+            const Attribute& attr = attrs[i];
+            IAttribute::value_t value;
+            switch (attr.kind)
+            {
+            case AttributeKind::Int: value = attr.int_value; break;
+            case AttributeKind::Double: value = attr.double_value; break;
+            case AttributeKind::String: value = str(attr.string_value); break;
+            }
+            result.push_back(IAttribute::Create(str(attr.name), IAttributeDefinition::EObjectType(attr.object_type), std::move(value)));
+        }
+        return result;
+    };
+    auto value_descriptions = [&](Span span)
+    {
+        std::vector<std::unique_ptr<IValueEncodingDescription>> result;
+        result.reserve(span.count);
+        const ValueDescription* descs = Records<ValueDescription>(ValueDescriptions) + span.first;
+        for (uint32_t i = 0; i < span.count; i++)
+        {
+            result.push_back(IValueEncodingDescription::Create(descs[i].value, str(descs[i].description)));
+        }
+        return result;
+    };
+
+    std::vector<std::unique_ptr<IAttributeDefinition>> attribute_definitions;
+    const AttributeDefinition* defs = Records<AttributeDefinition>(AttributeDefinitions);
+    for (std::size_t i = 0; i < Count(AttributeDefinitions); i++)
+    {
+        const AttributeDefinition& def = defs[i];
+        IAttributeDefinition::value_type_t value_type;
+        switch (def.kind)
+        {
+        case DefinitionKind::Int: value_type = IAttributeDefinition::ValueTypeInt{def.int_minimum, def.int_maximum}; break;
+        case DefinitionKind::Hex: value_type = IAttributeDefinition::ValueTypeHex{def.int_minimum, def.int_maximum}; break;
+        case DefinitionKind::Float: value_type = IAttributeDefinition::ValueTypeFloat{def.float_minimum, def.float_maximum}; break;
+        case DefinitionKind::String: value_type = IAttributeDefinition::ValueTypeString{}; break;
+        case DefinitionKind::Enum: value_type = IAttributeDefinition::ValueTypeEnum{strs(def.enum_values)}; break;
+        }
+        attribute_definitions.push_back(IAttributeDefinition::Create(
+            str(def.name), IAttributeDefinition::EObjectType(def.object_type), std::move(value_type)));
+    }
+
+    std::vector<std::unique_ptr<INode>> nodes;
+    const Node* node_recs = Records<Node>(Nodes);
+    for (std::size_t i = 0; i < Count(Nodes); i++)
+    {
+        nodes.push_back(INode::Create(str(node_recs[i].name), attributes(node_recs[i].attributes)));
+    }
+
+    std::vector<std::unique_ptr<IValueTable>> value_tables;
+    const ValueTable* vts = Records<ValueTable>(ValueTables);
+    for (std::size_t i = 0; i < Count(ValueTables); i++)
+    {
+        const ValueTable& vt = vts[i];
+        std::optional<std::unique_ptr<ISignalType>> signal_type;
+        if (vt.signal_type != npos)
+        {
+            const SignalType& st = Records<SignalType>(SignalTypes)[vt.signal_type];
+            signal_type = ISignalType::Create(
+                  str(st.name)
+                , st.size
+                , ISignal::EByteOrder(st.byte_order)
+                , ISignal::EValueType(st.value_type)
+                , st.factor
+                , st.offset
+                , st.minimum
+                , st.maximum
+                , str(st.unit)
+                , st.default_value
+                , str(st.value_table));
+        }
+        value_tables.push_back(IValueTable::Create(str(vt.name), std::move(signal_type), value_descriptions(vt.descriptions)));
+    }
+
+    std::vector<std::unique_ptr<IMessage>> messages;
+    messages.reserve(Count(Messages));
+    const Message* msgs = Records<Message>(Messages);
+    for (std::size_t i = 0; i < Count(Messages); i++)
+    {
+        const Message& msg = msgs[i];
+        std::vector<std::unique_ptr<ISignal>> signals;
+        signals.reserve(msg.signals.count);
+        const Signal* sigs = Records<Signal>(Signals) + msg.signals.first;
+        for (uint32_t j = 0; j < msg.signals.count; j++)
+        {
+            const Signal& sig = sigs[j];
+            std::vector<std::unique_ptr<ISignalMultiplexerValue>> mux_values;
+            const MuxValue* mvs = Records<MuxValue>(MuxValues) + sig.mux_values.first;
+            for (uint32_t k = 0; k < sig.mux_values.count; k++)
+            {
+                std::vector<ISignalMultiplexerValue::Range> ranges;
+                const MuxRange* rs = Records<MuxRange>(MuxRanges) + mvs[k].ranges.first;
+                for (uint32_t r = 0; r < mvs[k].ranges.count; r++)
+                {
+                    ranges.push_back({std::size_t(rs[r].from), std::size_t(rs[r].to)});
+                }
+                mux_values.push_back(ISignalMultiplexerValue::Create(str(mvs[k].switch_name), std::move(ranges)));
+            }
+            signals.push_back(ISignal::Create(
+                  msg.size
+                , str(sig.name)
+                , ISignal::EMultiplexer(sig.multiplexer)
+                , sig.mux_switch_value
+                , sig.start_bit
+                , sig.bit_size
+                , ISignal::EByteOrder(sig.byte_order)
+                , ISignal::EValueType(sig.value_type)
+                , sig.factor
+                , sig.offset
+                , sig.minimum
+                , sig.maximum
+                , str(sig.unit)
+                , strs(sig.receivers)
+                , attributes(sig.attributes)
+                , value_descriptions(sig.value_descriptions)
+                , ISignal::EExtendedValueType(sig.extended_value_type)
+                , std::move(mux_values)));
+        }
+        std::vector<std::unique_ptr<ISignalGroup>> signal_groups;
+        const SignalGroup* groups = Records<SignalGroup>(SignalGroups) + msg.signal_groups.first;
+        for (uint32_t j = 0; j < msg.signal_groups.count; j++)
+        {
+            signal_groups.push_back(ISignalGroup::Create(
+                groups[j].message_id, str(groups[j].name), groups[j].repetitions, strs(groups[j].signal_names)));
+        }
+        messages.push_back(IMessage::Create(
+              msg.id
+            , str(msg.name)
+            , msg.size
+            , str(msg.transmitter)
+            , strs(msg.transmitters)
+            , std::move(signals)
+            , attributes(msg.attributes)
+            , std::move(signal_groups)));
+    }
+
+    auto result = INetwork::Create(
+          str(_header->version_string)
+        , strs(_header->new_symbols)
+        , IBitTiming::Create(_header->baudrate, _header->btr1, _header->btr2)
+        , std::move(nodes)
+        , std::move(value_tables)
+        , std::move(messages)
+        , std::move(attribute_definitions)
+        , attributes(_header->attribute_defaults)
+        , attributes(_header->attribute_values));
+    static_cast<NetworkImpl&>(*result).AdoptStrings(std::move(strings));
+    return result;
+}
+
+bool INetwork::SaveSnapshot(const char* filename) const
+{
+    std::string data;
+    WriteSnapshot(*this, data);
+    // Written next to the target and renamed into place, so processes loading the snapshot
+    // concurrently (e.g. from a shared cache directory) never map a partially written file.
+    // The process id and a per process counter keep concurrent writers' temp files apart.
+    static std::atomic<unsigned long long> counter{0};
+#ifdef _WIN32
+    long pid = long(_getpid());
+#else
+    long pid = long(getpid());
+#endif
+    char suffix[48];
+    std::snprintf(suffix, sizeof(suffix), ".%ld.%llu.tmp", pid, counter++);
+    std::string temp = std::string(filename) + suffix;
+    FILE* file = std::fopen(temp.c_str(), "wb");
+    if (!file)
+    {
+        LOG_ERROR("Cannot open file for writing: %s", temp.c_str());
+        return false;
+    }
+    bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = std::fclose(file) == 0 && ok;
+    ok = ok && std::rename(temp.c_str(), filename) == 0;
+    if (!ok)
+    {
+        LOG_ERROR("Failed to write snapshot: %s", filename);
+        std::remove(temp.c_str());
+    }
+    return ok;
+}
+
+std::unique_ptr<INetwork> INetwork::LoadSnapshot(const char* filename)
+{
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        LOG_ERROR("Cannot open file: %s", filename);
+        return nullptr;
+    }
+    NetworkSnapshot snapshot;
+    if (!snapshot.Open(file.view()))
+    {
+        LOG_ERROR("Not a valid snapshot for this build: %s", filename);
+        return nullptr;
+    }
+    return snapshot.Materialize();
+}
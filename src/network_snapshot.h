@@ -0,0 +1,294 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+#include "dbcppp-tiny/network.h"
+#include "decode_plan.h"
+
+namespace dbcppp
+{
+    // Binary snapshot of a network as written by INetwork::SaveSnapshot.
+    //
+    // A snapshot is a Header followed by flat tables of fixed size records. Records refer to
+    // other records by table index and to strings by offset into the string pool only, so a
+    // snapshot is position independent and is used straight out of a read-only mapping.
+    // Lists (the signals of a message, the receivers of a signal, ...) are contiguous Spans of
+    // the table they refer to. Signals carry their precomputed DecodeStep, messages the number
+    // of bytes their steps read, so frames can be decoded from the mapping without building
+    // any objects.
+    //
+    // Fields are stored in the writer's native byte order and record layout. A snapshot is a
+    // cache of a DBC file for one machine and library version, not an interchange format:
+    // snapshots with a different version, byte order or record size are rejected.
+    namespace snapshot
+    {
+        constexpr char magic[8] = {'D', 'B', 'C', 'S', 'N', 'A', 'P', '\0'};
+        constexpr uint32_t version = 2;
+        constexpr uint32_t byte_order_mark = 0x01020304;
+        constexpr uint32_t npos = 0xFFFFFFFF;
+
+        struct Str
+        {
+            uint32_t offset;
+            uint32_t size;
+        };
+        struct Span
+        {
+            uint32_t first;
+            uint32_t count;
+        };
+
+        enum Table : uint32_t
+        {
+            Pool,
+            Strings,
+            Attributes,
+            AttributeDefinitions,
+            Nodes,
+            ValueDescriptions,
+            SignalTypes,
+            ValueTables,
+            MuxRanges,
+            MuxValues,
+            Signals,
+            SignalGroups,
+            Messages,
+            MessageIds,
+            TableCount
+        };
+
+        struct Section
+        {
+            uint64_t offset;
+            uint32_t count;
+            uint32_t record_size;
+        };
+
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t byte_order;
+            uint64_t file_size;
+            Section tables[TableCount];
+            uint64_t baudrate;
+            uint64_t btr1;
+            uint64_t btr2;
+            Str version_string;
+            // Strings
+            Span new_symbols;
+            // Attributes
+            Span attribute_defaults;
+            Span attribute_values;
+        };
+
+        // value kinds of IAttribute::value_t
+        enum class AttributeKind
+            : uint8_t
+        {
+            Int,
+            Double,
+            String
+        };
+        struct Attribute
+        {
+            Str name;
+            uint8_t object_type;
+            AttributeKind kind;
+            uint8_t reserved[6];
+            int64_t int_value;
+            double double_value;
+            Str string_value;
+        };
+
+        // alternatives of IAttributeDefinition::value_type_t
+        enum class DefinitionKind
+            : uint8_t
+        {
+            Int,
+            Hex,
+            Float,
+            String,
+            Enum
+        };
+        struct AttributeDefinition
+        {
+            Str name;
+            uint8_t object_type;
+            DefinitionKind kind;
+            uint8_t reserved[6];
+            int64_t int_minimum;
+            int64_t int_maximum;
+            double float_minimum;
+            double float_maximum;
+            // Strings
+            Span enum_values;
+        };
+
+        struct Node
+        {
+            Str name;
+            // Attributes
+            Span attributes;
+        };
+
+        struct ValueDescription
+        {
+            int64_t value;
+            Str description;
+        };
+
+        struct SignalType
+        {
+            Str name;
+            Str unit;
+            Str value_table;
+            uint64_t size;
+            double factor;
+            double offset;
+            double minimum;
+            double maximum;
+            double default_value;
+            uint8_t byte_order;
+            uint8_t value_type;
+            uint8_t reserved[6];
+        };
+
+        struct ValueTable
+        {
+            Str name;
+            // ValueDescriptions
+            Span descriptions;
+            // index into SignalTypes or npos
+            uint32_t signal_type;
+            uint32_t reserved;
+        };
+
+        struct MuxRange
+        {
+            uint64_t from;
+            uint64_t to;
+        };
+
+        struct MuxValue
+        {
+            Str switch_name;
+            // MuxRanges
+            Span ranges;
+        };
+
+        struct Signal
+        {
+            DecodeStep step;
+            Str name;
+            Str unit;
+            uint64_t start_bit;
+            uint64_t bit_size;
+            uint64_t mux_switch_value;
+            double factor;
+            double offset;
+            double minimum;
+            double maximum;
+            // Strings
+            Span receivers;
+            // ValueDescriptions
+            Span value_descriptions;
+            // Attributes
+            Span attributes;
+            // MuxValues
+            Span mux_values;
+            uint8_t multiplexer;
+            uint8_t byte_order;
+            uint8_t value_type;
+            uint8_t extended_value_type;
+            uint32_t reserved;
+        };
+
+        struct SignalGroup
+        {
+            uint64_t message_id;
+            uint64_t repetitions;
+            Str name;
+            // Strings
+            Span signal_names;
+        };
+
+        struct Message
+        {
+            uint64_t id;
+            uint64_t size;
+            Str name;
+            Str transmitter;
+            // Strings
+            Span transmitters;
+            // Signals
+            Span signals;
+            // Attributes
+            Span attributes;
+            // SignalGroups
+            Span signal_groups;
+            // number of bytes the decode steps of the signals read
+            uint32_t extent;
+            uint32_t reserved;
+        };
+
+        // Messages sorted by id for lookups without an index in memory
+        struct MessageId
+        {
+            uint64_t id;
+            uint32_t index;
+            uint32_t reserved;
+        };
+
+        static_assert(std::is_trivially_copyable_v<DecodeStep>, "DecodeStep is stored in snapshots");
+        static_assert(sizeof(Header) % 8 == 0, "tables following the header must stay 8 byte aligned");
+    }
+
+    void WriteSnapshot(const INetwork& net, std::string& out);
+
+    // Read-only view of a snapshot. Open() validates every record once, afterwards all
+    // accessors work directly on the caller's buffer without allocating or checking.
+    class NetworkSnapshot
+    {
+    public:
+        // data must be 8 byte aligned (a mapping or heap buffer) and outlive the view
+        bool Open(std::string_view data) noexcept;
+
+        const snapshot::Header& Header() const noexcept
+        {
+            return *_header;
+        }
+        template <class T>
+        const T* Records(snapshot::Table table) const noexcept
+        {
+            return reinterpret_cast<const T*>(_data + _header->tables[table].offset);
+        }
+        std::size_t Count(snapshot::Table table) const noexcept
+        {
+            return _header->tables[table].count;
+        }
+        std::string_view String(snapshot::Str str) const noexcept
+        {
+            return std::string_view(Records<char>(snapshot::Pool) + str.offset, str.size);
+        }
+
+        const snapshot::Message* FindMessage(uint64_t id) const noexcept;
+        // Decodes all signals of msg from the stored decode steps, like IMessage::DecodeAll
+        std::size_t DecodeAll(const snapshot::Message& msg, const void* bytes, std::size_t len, double* out) const noexcept;
+
+        // Builds a regular INetwork from the snapshot
+        std::unique_ptr<INetwork> Materialize() const;
+
+    private:
+        bool Validate() const noexcept;
+
+        const char* _data = nullptr;
+        std::size_t _size = 0;
+        const snapshot::Header* _header = nullptr;
+    };
+}
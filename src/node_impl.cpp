@@ -7,7 +7,8 @@ std::unique_ptr<INode> INode::Create(
     std::string&& name,
     std::vector<std::unique_ptr<IAttribute>>&& attribute_values)
 {
-    std::vector<AttributeImpl> avs;
+    ArenaVector<AttributeImpl> avs;
+    avs.reserve(attribute_values.size());
     for (auto& av : attribute_values)
     {
         avs.push_back(std::move(static_cast<AttributeImpl&>(*av)));
@@ -15,7 +16,7 @@ std::unique_ptr<INode> INode::Create(
     }
     return std::make_unique<NodeImpl>(std::move(name), std::move(avs));
 }
-NodeImpl::NodeImpl(std::string&& name, std::vector<AttributeImpl>&& attribute_values)
+NodeImpl::NodeImpl(std::string&& name, ArenaVector<AttributeImpl>&& attribute_values)
     : _name(std::move(name))
     , _attribute_values(std::move(attribute_values))
 {}
@@ -5,6 +5,7 @@
 
 #include "dbcppp-tiny/node.h"
 #include "attribute_impl.h"
+#include "arena.h"
 
 namespace dbcppp
 {
@@ -14,14 +15,14 @@ namespace dbcppp
     public:
         NodeImpl(
               std::string&& name
-            , std::vector<AttributeImpl>&& attribute_values);
+            , ArenaVector<AttributeImpl>&& attribute_values);
             
         virtual const std::string& Name() const override;
         virtual const IAttribute& AttributeValues_Get(std::size_t i) const override;
         virtual uint64_t AttributeValues_Size() const override;
 
     private:
-        std::string _name;
-        std::vector<AttributeImpl> _attribute_values;
+        PooledString _name;
+        ArenaVector<AttributeImpl> _attribute_values;
     };
 }
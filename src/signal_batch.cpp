@@ -0,0 +1,243 @@
+#include <type_traits>
+#include "signal_batch.h"
+
+#ifdef DBCPPP_X86_DISPATCH
+#   include <immintrin.h>
+#endif
+
+using namespace dbcppp;
+
+namespace
+{
+    bool vectorizable(const DecodeStep& step)
+    {
+        if (step.value != DecodeStep::EValue::Unsigned && step.value != DecodeStep::EValue::Signed)
+        {
+            return false;
+        }
+        return step.kind != DecodeStep::EKind::SpanLittleEndian && step.kind != DecodeStep::EKind::SpanBigEndian;
+    }
+    bool big_endian(const DecodeStep& step)
+    {
+        return step.kind == DecodeStep::EKind::FirstBigEndian || step.kind == DecodeStep::EKind::BigEndian;
+    }
+    // bits set by sign extension: the sign bit and everything above it
+    uint64_t sign_extension_mask(const DecodeStep& step)
+    {
+        return ~0ull << (63 - step.sign_shift);
+    }
+    // first-8-byte signals are loaded from offset 0 like the decode plan does
+    std::size_t load_offset(const DecodeStep& step)
+    {
+        return step.kind == DecodeStep::EKind::FirstLittleEndian || step.kind == DecodeStep::EKind::FirstBigEndian ? 0 : step.byte_pos;
+    }
+
+    template <class Out>
+    void decode_scalar(const DecodeStep& step, const uint8_t* frames, std::size_t stride, std::size_t i, std::size_t n, Out* out)
+    {
+        for (; i < n; i++)
+        {
+            const uint8_t* frame = frames + i * stride;
+            uint64_t first_le = DecodePlan::Load64(frame);
+            uint64_t first_be = first_le;
+            native_to_little_inplace(first_le);
+            native_to_big_inplace(first_be);
+            uint64_t raw = DecodePlan::Extract(step, frame, first_le, first_be);
+            if constexpr (std::is_same_v<Out, double>)
+            {
+                out[i] = DecodePlan::RawToPhys(step, raw);
+            }
+            else
+            {
+                out[i] = raw;
+            }
+        }
+    }
+
+#ifdef DBCPPP_X86_DISPATCH
+    // The kernels multiply and add separately (no FMA) so the results are bit identical to RawToPhys.
+    // 64 bit integer -> double conversions use the exact magic number sequences since AVX2 has no cvtepi64_pd.
+
+    __attribute__((target("avx2")))
+    inline __m256d u64_to_double_avx2(__m256i x)
+    {
+        __m256i xh = _mm256_srli_epi64(x, 32);
+        xh = _mm256_or_si256(xh, _mm256_castpd_si256(_mm256_set1_pd(19342813113834066795298816.)));          // 2^84
+        __m256i xl = _mm256_blend_epi16(x, _mm256_castpd_si256(_mm256_set1_pd(0x0010000000000000)), 0xcc);  // 2^52
+        __m256d f = _mm256_sub_pd(_mm256_castsi256_pd(xh), _mm256_set1_pd(19342813118337666422669312.));    // 2^84 + 2^52
+        return _mm256_add_pd(f, _mm256_castsi256_pd(xl));
+    }
+    __attribute__((target("avx2")))
+    inline __m256d i64_to_double_avx2(__m256i x)
+    {
+        __m256i xh = _mm256_srai_epi32(x, 16);
+        xh = _mm256_blend_epi16(xh, _mm256_setzero_si256(), 0x33);
+        xh = _mm256_add_epi64(xh, _mm256_castpd_si256(_mm256_set1_pd(442721857769029238784.)));              // 3 * 2^67
+        __m256i xl = _mm256_blend_epi16(x, _mm256_castpd_si256(_mm256_set1_pd(0x0010000000000000)), 0x88);  // 2^52
+        __m256d f = _mm256_sub_pd(_mm256_castsi256_pd(xh), _mm256_set1_pd(442726361368656609280.));         // 3 * 2^67 + 2^52
+        return _mm256_add_pd(f, _mm256_castsi256_pd(xl));
+    }
+    template <class Out>
+    __attribute__((target("avx2")))
+    void decode_avx2(const DecodeStep& step, const uint8_t* frames, std::size_t stride, std::size_t n, Out* out)
+    {
+        const uint8_t* base = frames + load_offset(step);
+        const __m256i bswap = _mm256_setr_epi8(
+            7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+            7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        const __m256i mask = _mm256_set1_epi64x(int64_t(step.mask));
+        const __m256i mask_signed = _mm256_set1_epi64x(int64_t(sign_extension_mask(step)));
+        const __m128i shift = _mm_cvtsi32_si128(step.shift0);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256d factor = _mm256_set1_pd(step.factor);
+        const __m256d offset = _mm256_set1_pd(step.offset);
+        const bool be = big_endian(step);
+        const bool sign = step.value == DecodeStep::EValue::Signed;
+        const __m256i lane = _mm256_setr_epi64x(0, int64_t(stride), int64_t(2 * stride), int64_t(3 * stride));
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i index = _mm256_add_epi64(_mm256_set1_epi64x(int64_t(i * stride)), lane);
+            __m256i v = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(base), index, 1);
+            if (be)
+            {
+                v = _mm256_shuffle_epi8(v, bswap);
+            }
+            v = _mm256_and_si256(_mm256_srl_epi64(v, shift), mask);
+            if (sign)
+            {
+                __m256i clear = _mm256_cmpeq_epi64(_mm256_and_si256(v, mask_signed), zero);
+                v = _mm256_or_si256(v, _mm256_andnot_si256(clear, mask_signed));
+            }
+            if constexpr (std::is_same_v<Out, double>)
+            {
+                __m256d d = sign ? i64_to_double_avx2(v) : u64_to_double_avx2(v);
+                _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_mul_pd(d, factor), offset));
+            }
+            else
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+            }
+        }
+        decode_scalar(step, frames, stride, i, n, out);
+    }
+
+    __attribute__((target("sse4.1")))
+    inline __m128d u64_to_double_sse41(__m128i x)
+    {
+        __m128i xh = _mm_srli_epi64(x, 32);
+        xh = _mm_or_si128(xh, _mm_castpd_si128(_mm_set1_pd(19342813113834066795298816.)));
+        __m128i xl = _mm_blend_epi16(x, _mm_castpd_si128(_mm_set1_pd(0x0010000000000000)), 0xcc);
+        __m128d f = _mm_sub_pd(_mm_castsi128_pd(xh), _mm_set1_pd(19342813118337666422669312.));
+        return _mm_add_pd(f, _mm_castsi128_pd(xl));
+    }
+    __attribute__((target("sse4.1")))
+    inline __m128d i64_to_double_sse41(__m128i x)
+    {
+        __m128i xh = _mm_srai_epi32(x, 16);
+        xh = _mm_blend_epi16(xh, _mm_setzero_si128(), 0x33);
+        xh = _mm_add_epi64(xh, _mm_castpd_si128(_mm_set1_pd(442721857769029238784.)));
+        __m128i xl = _mm_blend_epi16(x, _mm_castpd_si128(_mm_set1_pd(0x0010000000000000)), 0x88);
+        __m128d f = _mm_sub_pd(_mm_castsi128_pd(xh), _mm_set1_pd(442726361368656609280.));
+        return _mm_add_pd(f, _mm_castsi128_pd(xl));
+    }
+    template <class Out>
+    __attribute__((target("sse4.1")))
+    void decode_sse41(const DecodeStep& step, const uint8_t* frames, std::size_t stride, std::size_t n, Out* out)
+    {
+        const uint8_t* base = frames + load_offset(step);
+        const __m128i bswap = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        const __m128i mask = _mm_set1_epi64x(int64_t(step.mask));
+        const __m128i mask_signed = _mm_set1_epi64x(int64_t(sign_extension_mask(step)));
+        const __m128i shift = _mm_cvtsi32_si128(step.shift0);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128d factor = _mm_set1_pd(step.factor);
+        const __m128d offset = _mm_set1_pd(step.offset);
+        const bool be = big_endian(step);
+        const bool sign = step.value == DecodeStep::EValue::Signed;
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128i v = _mm_set_epi64x(
+                int64_t(DecodePlan::Load64(base + (i + 1) * stride)),
+                int64_t(DecodePlan::Load64(base + i * stride)));
+            if (be)
+            {
+                v = _mm_shuffle_epi8(v, bswap);
+            }
+            v = _mm_and_si128(_mm_srl_epi64(v, shift), mask);
+            if (sign)
+            {
+                __m128i clear = _mm_cmpeq_epi64(_mm_and_si128(v, mask_signed), zero);
+                v = _mm_or_si128(v, _mm_andnot_si128(clear, mask_signed));
+            }
+            if constexpr (std::is_same_v<Out, double>)
+            {
+                __m128d d = sign ? i64_to_double_sse41(v) : u64_to_double_sse41(v);
+                _mm_storeu_pd(out + i, _mm_add_pd(_mm_mul_pd(d, factor), offset));
+            }
+            else
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+            }
+        }
+        decode_scalar(step, frames, stride, i, n, out);
+    }
+#endif
+
+    template <class Out>
+    void decode_batch(const DecodeStep& step, const uint8_t* frames, std::size_t stride, std::size_t n, Out* out, BatchIsa isa)
+    {
+        // the vector kernels assume little endian lanes
+        if (dbcppp::Endian::Native != dbcppp::Endian::Little || !vectorizable(step) || !BatchIsaSupported(isa))
+        {
+            isa = BatchIsa::Scalar;
+        }
+#ifdef DBCPPP_COMPACT_DESCRIPTORS
+        // the vector kernels scale in double precision, RawToPhys in single precision
+        if constexpr (std::is_same_v<Out, double>)
+        {
+            isa = BatchIsa::Scalar;
+        }
+#endif
+        switch (isa)
+        {
+#ifdef DBCPPP_X86_DISPATCH
+        case BatchIsa::AVX2:
+            decode_avx2(step, frames, stride, n, out);
+            return;
+        case BatchIsa::SSE41:
+            decode_sse41(step, frames, stride, n, out);
+            return;
+#endif
+        default:
+            decode_scalar(step, frames, stride, 0, n, out);
+            return;
+        }
+    }
+}
+
+BatchIsa dbcppp::DetectBatchIsa() noexcept
+{
+    if (CpuSupportsAvx2())
+    {
+        return BatchIsa::AVX2;
+    }
+    if (CpuSupportsSse41())
+    {
+        return BatchIsa::SSE41;
+    }
+    return BatchIsa::Scalar;
+}
+bool dbcppp::BatchIsaSupported(BatchIsa isa) noexcept
+{
+    return int(isa) <= int(DetectBatchIsa());
+}
+void dbcppp::DecodeBatch(const DecodeStep& step, const uint8_t* frames, std::size_t stride, std::size_t n, uint64_t* out, BatchIsa isa) noexcept
+{
+    decode_batch(step, frames, stride, n, out, isa);
+}
+void dbcppp::DecodeBatch(const DecodeStep& step, const uint8_t* frames, std::size_t stride, std::size_t n, double* out, BatchIsa isa) noexcept
+{
+    decode_batch(step, frames, stride, n, out, isa);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "decode_plan.h"
+#include "cpu_features.h"
+
+namespace dbcppp
+{
+    // Instruction sets the batch kernels are compiled for, selected at runtime
+    enum class BatchIsa
+    {
+        Scalar,
+        SSE41,
+        AVX2
+    };
+
+    // best instruction set supported by the running CPU (detected once)
+    BatchIsa DetectBatchIsa() noexcept;
+    bool BatchIsaSupported(BatchIsa isa) noexcept;
+
+    // Decodes the signal described by step from n frames starting at frames, frame i begins at frames + i * stride.
+    // Every frame has to satisfy the same size requirements as ISignal::Decode.
+    // Integer signals readable with one 64 bit load are vectorized, all other signals take the scalar path.
+    void DecodeBatch(const DecodeStep& step, const uint8_t* frames, std::size_t stride, std::size_t n, uint64_t* out, BatchIsa isa) noexcept;
+    void DecodeBatch(const DecodeStep& step, const uint8_t* frames, std::size_t stride, std::size_t n, double* out, BatchIsa isa) noexcept;
+}
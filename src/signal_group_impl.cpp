@@ -26,7 +26,7 @@ SignalGroupImpl::SignalGroupImpl(
     : _message_id(message_id)
     , _name(std::move(name))
     , _repetitions(repetitions)
-    , _signal_names(std::move(signal_names))
+    , _signal_names(std::make_move_iterator(signal_names.begin()), std::make_move_iterator(signal_names.end()))
 {}
 uint64_t SignalGroupImpl::MessageId() const
 {
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <dbcppp-tiny/signal_group.h>
+#include "arena.h"
 
 namespace dbcppp
 {
@@ -24,6 +25,6 @@ namespace dbcppp
         uint64_t _message_id;
         std::string _name;
         uint64_t _repetitions;
-        std::vector<std::string> _signal_names;
+        ArenaVector<std::string> _signal_names;
     };
 }
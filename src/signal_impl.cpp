@@ -1,16 +1,17 @@
 #include <algorithm>
+#include <cstring>
 #include <limits>
+#include <type_traits>
 #include "helper.h"
+#include "cpu_features.h"
 #include "signal_impl.h"
+#include "signal_batch.h"
 
-using namespace dbcppp;
+#ifdef DBCPPP_X86_DISPATCH
+#   include <immintrin.h>
+#endif
 
-enum class Alignment
-{
-    size_inbetween_first_64_bit,
-    signal_exceeds_64_bit_size_but_signal_fits_into_64_bit,
-    signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit
-};
+using namespace dbcppp;
 
 template <Alignment aAlignment, ISignal::EByteOrder aByteOrder, ISignal::EValueType aValueType, ISignal::EExtendedValueType aExtendedValueType>
 ISignal::raw_t template_decode(const ISignal* sig, const void* nbytes) noexcept
@@ -46,10 +47,7 @@ ISignal::raw_t template_decode(const ISignal* sig, const void* nbytes) noexcept
         }
         if constexpr (aValueType == ISignal::EValueType::Signed)
         {
-            if (data & sigi->_mask_signed)
-            {
-                data |= sigi->_mask_signed;
-            }
+            data = uint64_t(int64_t(data << sigi->_sign_shift) >> sigi->_sign_shift);
         }
         return data;
     }
@@ -87,14 +85,37 @@ ISignal::raw_t template_decode(const ISignal* sig, const void* nbytes) noexcept
     if constexpr (aValueType == ISignal::EValueType::Signed)
     {
         // bit extending
-        // trust the compiler to optimize this
-        if (data & sigi->_mask_signed)
-        {
-            data |= sigi->_mask_signed;
-        }
+        data = uint64_t(int64_t(data << sigi->_sign_shift) >> sigi->_sign_shift);
+    }
+    return data;
+}
+#ifdef DBCPPP_COMPACT_DESCRIPTORS
+// Variant of template_decode for integer signals within one 32 bit load, which keeps the
+// shift, mask and sign extension in 32 bit registers on 32 bit cores.
+template <ISignal::EByteOrder aByteOrder, ISignal::EValueType aValueType>
+ISignal::raw_t template_decode_32(const ISignal* sig, const void* nbytes) noexcept
+{
+    const SignalImpl* sigi = static_cast<const SignalImpl*>(sig);
+    uint32_t data = *reinterpret_cast<const uint32_t*>(&reinterpret_cast<const uint8_t*>(nbytes)[sigi->_byte_pos]);
+    if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+    {
+        native_to_big_inplace(data);
+    }
+    else
+    {
+        native_to_little_inplace(data);
+    }
+    data >>= sigi->_fixed_start_bit_0;
+    data &= uint32_t(sigi->_mask);
+    if constexpr (aValueType == ISignal::EValueType::Signed)
+    {
+        // _sign_shift is 64 - _bit_size
+        uint32_t sign_shift = sigi->_sign_shift - 32u;
+        return ISignal::raw_t(int64_t(int32_t(data << sign_shift) >> sign_shift));
     }
     return data;
 }
+#endif
 
 constexpr uint64_t enum_mask(Alignment a, ISignal::EByteOrder bo, ISignal::EValueType vt, ISignal::EExtendedValueType evt)
 {
@@ -104,6 +125,7 @@ constexpr uint64_t enum_mask(Alignment a, ISignal::EByteOrder bo, ISignal::EValu
     case Alignment::size_inbetween_first_64_bit:                                    result |= 0b1; break;
     case Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit:         result |= 0b10; break;
     case Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit: result |= 0b100; break;
+    case Alignment::signal_fits_into_32_bit:                                        result |= 0b10000000000; break;
     }
     switch (bo)
     {
@@ -136,6 +158,16 @@ decode_func_t make_decode(Alignment a, ISignal::EByteOrder bo, ISignal::EValueTy
     constexpr auto i                = ISignal::EExtendedValueType::Integer;
     constexpr auto f                = ISignal::EExtendedValueType::Float;
     constexpr auto d                = ISignal::EExtendedValueType::Double;
+#ifdef DBCPPP_COMPACT_DESCRIPTORS
+    if (a == Alignment::signal_fits_into_32_bit)
+    {
+        if (bo == le)
+        {
+            return vt == sig ? template_decode_32<le, sig> : template_decode_32<le, usig>;
+        }
+        return vt == sig ? template_decode_32<be, sig> : template_decode_32<be, usig>;
+    }
+#endif
     switch (enum_mask(a, bo, vt, evt))
     {
     case enum_mask(si64b, le, sig, i):            return template_decode<si64b, le, sig, i>;
@@ -177,12 +209,85 @@ decode_func_t make_decode(Alignment a, ISignal::EByteOrder bo, ISignal::EValueTy
     }
     return nullptr;
 }
+#ifdef DBCPPP_X86_DISPATCH
+// BMI2 variant of template_decode for signals which fit into one 64 bit load:
+// the word is brought into signal byte order (Motorola signals are byte swapped, which
+// turns the bit-reversed Motorola layout into one contiguous field) and the field is
+// gathered with a single pext. Signed values are extended with a shift pair instead
+// of the test/or sequence. Float and double take the unsigned path like in template_decode.
+template <Alignment aAlignment, ISignal::EByteOrder aByteOrder, bool aSigned>
+__attribute__((target("bmi2")))
+ISignal::raw_t template_decode_pext(const ISignal* sig, const void* nbytes) noexcept
+{
+    const SignalImpl* sigi = static_cast<const SignalImpl*>(sig);
+    // memcpy instead of a uint64_t dereference, the frame and _byte_pos are not 8 byte aligned
+    uint64_t data;
+    if constexpr (aAlignment == Alignment::size_inbetween_first_64_bit)
+    {
+        std::memcpy(&data, nbytes, sizeof(data));
+    }
+    else
+    {
+        std::memcpy(&data, reinterpret_cast<const uint8_t*>(nbytes) + sigi->_byte_pos, sizeof(data));
+    }
+    if constexpr (aByteOrder == ISignal::EByteOrder::BigEndian)
+    {
+        native_to_big_inplace(data);
+    }
+    else
+    {
+        native_to_little_inplace(data);
+    }
+    data = _pext_u64(data, sigi->_pext_mask);
+    if constexpr (aSigned)
+    {
+        data = uint64_t(int64_t(data << sigi->_sign_shift) >> sigi->_sign_shift);
+    }
+    return data;
+}
+decode_func_t make_decode_pext(Alignment a, ISignal::EByteOrder bo, bool is_signed)
+{
+    constexpr auto si64b            = Alignment::size_inbetween_first_64_bit;
+    constexpr auto se64bsbsfi64b    = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
+    constexpr auto le               = ISignal::EByteOrder::LittleEndian;
+    constexpr auto be               = ISignal::EByteOrder::BigEndian;
+    if (a == si64b)
+    {
+        if (bo == le)
+        {
+            return is_signed ? template_decode_pext<si64b, le, true> : template_decode_pext<si64b, le, false>;
+        }
+        return is_signed ? template_decode_pext<si64b, be, true> : template_decode_pext<si64b, be, false>;
+    }
+    if (a == se64bsbsfi64b)
+    {
+        if (bo == le)
+        {
+            return is_signed ? template_decode_pext<se64bsbsfi64b, le, true> : template_decode_pext<se64bsbsfi64b, le, false>;
+        }
+        return is_signed ? template_decode_pext<se64bsbsfi64b, be, true> : template_decode_pext<se64bsbsfi64b, be, false>;
+    }
+    return nullptr;
+}
+#endif
 template <class T>
 double raw_to_phys(const ISignal* sig, ISignal::raw_t raw) noexcept
 {
     const SignalImpl* sigi = static_cast<const SignalImpl*>(sig);
-    double draw = double(*reinterpret_cast<T*>(&raw));
-    return draw * sigi->Factor() + sigi->Offset();
+    if constexpr (std::is_same_v<T, double>)
+    {
+        // doubles are scaled in double precision, also with single precision factor and offset
+        double value;
+        std::memcpy(&value, &raw, sizeof(value));
+        return value * sigi->_factor + sigi->_offset;
+    }
+    else
+    {
+        T value;
+        std::memcpy(&value, &raw, sizeof(value));
+        scale_t draw = scale_t(value);
+        return draw * sigi->_factor + sigi->_offset;
+    }
 }
 std::unique_ptr<ISignal> ISignal::Create(
       uint64_t message_size
@@ -205,19 +310,22 @@ std::unique_ptr<ISignal> ISignal::Create(
     , std::vector<std::unique_ptr<ISignalMultiplexerValue>>&& signal_multiplexer_values)
 {
     std::unique_ptr<SignalImpl> result;
-    std::vector<AttributeImpl> avs;
+    ArenaVector<AttributeImpl> avs;
+    avs.reserve(attribute_values.size());
     for (auto& av : attribute_values)
     {
         avs.push_back(std::move(static_cast<AttributeImpl&>(*av)));
         av.reset(nullptr);
     }
-    std::vector<ValueEncodingDescriptionImpl> veds;
+    ArenaVector<ValueEncodingDescriptionImpl> veds;
+    veds.reserve(value_encoding_descriptions.size());
     for (auto& ved : value_encoding_descriptions)
     {
         veds.push_back(std::move(static_cast<ValueEncodingDescriptionImpl&>(*ved)));
         ved.reset(nullptr);
     }
-    std::vector<SignalMultiplexerValueImpl> smvs;
+    ArenaVector<SignalMultiplexerValueImpl> smvs;
+    smvs.reserve(signal_multiplexer_values.size());
     for (auto& smv : signal_multiplexer_values)
     {
         smvs.push_back(std::move(static_cast<SignalMultiplexerValueImpl&>(*smv)));
@@ -260,29 +368,30 @@ SignalImpl::SignalImpl(
     , double maximum
     , std::string&& unit
     , std::vector<std::string>&& receivers
-    , std::vector<AttributeImpl>&& attribute_values
-    , std::vector<ValueEncodingDescriptionImpl>&& value_encoding_descriptions
+    , ArenaVector<AttributeImpl>&& attribute_values
+    , ArenaVector<ValueEncodingDescriptionImpl>&& value_encoding_descriptions
     , EExtendedValueType extended_value_type
-    , std::vector<SignalMultiplexerValueImpl>&& signal_multiplexer_values)
+    , ArenaVector<SignalMultiplexerValueImpl>&& signal_multiplexer_values)
     
-    : _name(std::move(name))
-    , _multiplexer_indicator(std::move(multiplexer_indicator))
+    : _factor(scale_t(factor))
+    , _offset(scale_t(offset))
+    , _name(std::move(name))
     , _multiplexer_switch_value(std::move(multiplexer_switch_value))
-    , _start_bit(std::move(start_bit))
-    , _bit_size(std::move(bit_size))
+    , _minimum(scale_t(minimum))
+    , _maximum(scale_t(maximum))
+    , _start_bit(bit_pos_t(start_bit))
+    , _bit_size(bit_pos_t(bit_size))
+    , _multiplexer_indicator(std::move(multiplexer_indicator))
     , _byte_order(std::move(byte_order))
     , _value_type(std::move(value_type))
-    , _factor(std::move(factor))
-    , _offset(std::move(offset))
-    , _minimum(std::move(minimum))
-    , _maximum(std::move(maximum))
+    , _extended_value_type(std::move(extended_value_type))
+    , _error(EErrorCode::NoError)
     , _unit(std::move(unit))
-    , _receivers(std::move(receivers))
+    , _receivers(std::make_move_iterator(receivers.begin()), std::make_move_iterator(receivers.end()))
     , _attribute_values(std::move(attribute_values))
     , _value_encoding_descriptions(std::move(value_encoding_descriptions))
-    , _extended_value_type(std::move(extended_value_type))
     , _signal_multiplexer_values(std::move(signal_multiplexer_values))
-    , _error(EErrorCode::NoError)
+    , _message(nullptr)
 {
     message_size = message_size < 8 ? 8 : message_size;
     // check for out of frame size error
@@ -331,80 +440,60 @@ SignalImpl::SignalImpl(
     }
 
     // save some additional values to speed up decoding
-    // CAN signals can be upto 64 bits in size but doing a shift of more than 63 bytes is undefined behavior
-    _mask =  (1ull << (_bit_size - 1ull) << 1ull) - 1;
-    _mask_signed = ~((1ull << (_bit_size - 1ull)) - 1);
-
-    _byte_pos = _start_bit / 8;
+    SignalLayout layout = SignalLayout::Create(start_bit, bit_size, byte_order);
+    _mask = layout.mask;
+    uint64_t byte_pos = layout.byte_pos;
+    uint64_t fixed_start_bit_0 = layout.fixed_start_bit_0;
+    uint64_t fixed_start_bit_1 = layout.fixed_start_bit_1;
+    Alignment alignment = layout.alignment;
 
+#ifdef DBCPPP_COMPACT_DESCRIPTORS
     uint64_t nbytes;
-    if (_byte_order == EByteOrder::LittleEndian)
+    if (byte_order == EByteOrder::LittleEndian)
     {
-        nbytes = (_start_bit % 8 + _bit_size + 7) / 8;
+        nbytes = (start_bit % 8 + bit_size + 7) / 8;
     }
     else
     {
-        nbytes = (_bit_size + (7 - _start_bit % 8) + 7) / 8;
+        nbytes = (bit_size + (7 - start_bit % 8) + 7) / 8;
     }
-    Alignment alignment = Alignment::size_inbetween_first_64_bit;
-    // check whether the data is in the first 8 bytes
-    // so we can optimize out one memory access
-    if (_byte_pos + nbytes <= 8)
+    // integer signals within 4 bytes are read with one 32 bit load, the load is moved
+    // towards the start of the frame if it would read past the end of the message
+    uint64_t window = std::min(start_bit / 8, message_size - 4);
+    if (extended_value_type == EExtendedValueType::Integer && bit_size >= 1 && bit_size <= 32 &&
+        start_bit / 8 + nbytes <= window + 4)
     {
-        alignment = Alignment::size_inbetween_first_64_bit;
-        if (_byte_order == EByteOrder::LittleEndian)
+        alignment = Alignment::signal_fits_into_32_bit;
+        byte_pos = window;
+        if (byte_order == EByteOrder::LittleEndian)
         {
-            _fixed_start_bit_0 = _start_bit;
+            fixed_start_bit_0 = start_bit - window * 8;
         }
         else
         {
-            _fixed_start_bit_0 = (8 * (7 - (_start_bit / 8))) + (_start_bit % 8) - (_bit_size - 1);
+            fixed_start_bit_0 = (8 * (3 - (start_bit / 8 - window))) + (start_bit % 8) - (bit_size - 1);
         }
     }
-    // check whether we can align the data on 64 bit
-    else if (_byte_pos  % 8 + nbytes <= 8)
+#endif
+
+    _byte_pos = byte_pos_t(byte_pos);
+    _fixed_start_bit_0 = uint8_t(fixed_start_bit_0 & 63);
+    _fixed_start_bit_1 = uint8_t(fixed_start_bit_1 & 63);
+    _alignment = alignment;
+#ifdef DBCPPP_X86_DISPATCH
+    _pext_mask = fixed_start_bit_0 < 64 ? _mask << fixed_start_bit_0 : 0;
+    if (_extended_value_type == EExtendedValueType::Double)
     {
-        alignment = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
-        // align the byte pos on 64 bit
-        _byte_pos -= _byte_pos % 8;
-        _fixed_start_bit_0 = _start_bit - _byte_pos * 8;
-        if (_byte_order == EByteOrder::BigEndian)
-        {
-            _fixed_start_bit_0 = (8 * (7 - (_fixed_start_bit_0 / 8))) + (_fixed_start_bit_0 % 8) - (_bit_size - 1);
-        }
+        // template_decode takes doubles which fit into one load as is
+        _pext_mask = ~0ull;
     }
-    // we aren't able to align the data on 64 bit, so check whether the data fits into on uint64_t
-    else if (nbytes <= 8)
+#endif
+    _sign_shift = uint8_t((64 - bit_size) & 63);
+    _decode = ::make_decode(alignment, _byte_order, _value_type, _extended_value_type);
+    if (CpuHasFastPext())
     {
-        alignment = Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit;
-        _fixed_start_bit_0 = _start_bit - _byte_pos * 8;
-        if (_byte_order == EByteOrder::BigEndian)
-        {
-            _fixed_start_bit_0 = (8 * (7 - (_fixed_start_bit_0 / 8))) + (_fixed_start_bit_0 % 8) - (_bit_size - 1);
-        }
+        SelectDecodeKernel(DecodeKernel::Pext);
     }
-    // we aren't able to align the data on 64 bit, and we aren't able to fit the data into one uint64_t
-    // so we have to compose the resulting value
-    else
-    {
-        alignment = Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit;
-        if (_byte_order == EByteOrder::BigEndian)
-        {
-            uint64_t nbits_last_byte = (7 - _start_bit % 8) + _bit_size - 64;
-            _fixed_start_bit_0 = nbits_last_byte;
-            _fixed_start_bit_1 = 8 - nbits_last_byte;
-            _mask = (1ull << (_start_bit % 8 + 57)) - 1;
-        }
-        else
-        {
-            _fixed_start_bit_0 = _start_bit - _byte_pos * 8;
-            _fixed_start_bit_1 = 64 - _start_bit % 8;
-            uint64_t nbits_last_byte = _bit_size + _start_bit % 8 - 64;
-            _mask = (1ull << nbits_last_byte) - 1ull;
-        }
-    }
-
-    _decode = ::make_decode(alignment, _byte_order, _value_type, _extended_value_type);
     switch (_extended_value_type)
     {
     case EExtendedValueType::Integer:
@@ -490,6 +579,10 @@ uint64_t SignalImpl::ValueEncodingDescriptions_Size() const
 {
     return _value_encoding_descriptions.size();
 }
+ObjectSpan<IValueEncodingDescription> SignalImpl::ValueEncodingDescriptions() const
+{
+    return {_value_encoding_descriptions.data(), _value_encoding_descriptions.size()};
+}
 const IAttribute& SignalImpl::AttributeValues_Get(std::size_t i) const
 {
     return _attribute_values[i];
@@ -498,6 +591,10 @@ uint64_t SignalImpl::AttributeValues_Size() const
 {
     return _attribute_values.size();
 }
+ObjectSpan<IAttribute> SignalImpl::AttributeValues() const
+{
+    return {_attribute_values.data(), _attribute_values.size()};
+}
 ISignal::EExtendedValueType SignalImpl::ExtendedValueType() const
 {
     return _extended_value_type;
@@ -510,11 +607,54 @@ uint64_t SignalImpl::SignalMultiplexerValues_Size() const
 {
     return _signal_multiplexer_values.size();
 }
+ObjectSpan<ISignalMultiplexerValue> SignalImpl::SignalMultiplexerValues() const
+{
+    return {_signal_multiplexer_values.data(), _signal_multiplexer_values.size()};
+}
 bool SignalImpl::Error(EErrorCode code) const
 {
-    return code == _error || (uint64_t(_error) & uint64_t(code));
+    return code == _error || (uint64_t(EErrorCode(_error)) & uint64_t(code));
+}
+void SignalImpl::DecodeBatch(const void* frames, std::size_t stride, std::size_t n, raw_t* out) const noexcept
+{
+    dbcppp::DecodeBatch(DecodePlan::MakeStep(*this), reinterpret_cast<const uint8_t*>(frames), stride, n, out, DetectBatchIsa());
+}
+void SignalImpl::DecodeBatch(const void* frames, std::size_t stride, std::size_t n, double* out) const noexcept
+{
+    dbcppp::DecodeBatch(DecodePlan::MakeStep(*this), reinterpret_cast<const uint8_t*>(frames), stride, n, out, DetectBatchIsa());
+}
+bool SignalImpl::SelectDecodeKernel(DecodeKernel kernel) noexcept
+{
+    decode_func_t decode = nullptr;
+#ifdef DBCPPP_X86_DISPATCH
+    if (kernel == DecodeKernel::Pext && CpuSupportsBmi2() && _bit_size >= 1 && _bit_size <= 64)
+    {
+        bool is_signed = _extended_value_type == EExtendedValueType::Integer && _value_type == EValueType::Signed;
+        decode = ::make_decode_pext(_alignment, _byte_order, is_signed);
+    }
+#endif
+    if (decode == nullptr)
+    {
+        _decode = ::make_decode(_alignment, _byte_order, _value_type, _extended_value_type);
+        return kernel == DecodeKernel::Template;
+    }
+    _decode = decode;
+    return true;
+}
+DecodeKernel SignalImpl::SelectedDecodeKernel() const noexcept
+{
+    return _decode == ::make_decode(_alignment, _byte_order, _value_type, _extended_value_type)
+        ? DecodeKernel::Template : DecodeKernel::Pext;
+}
+const IMessage* SignalImpl::Message() const noexcept
+{
+    return _message;
+}
+void SignalImpl::SetMessage(const IMessage* message) noexcept
+{
+    _message = message;
 }
 void SignalImpl::SetError(EErrorCode code)
 {
-    _error = EErrorCode(uint64_t(_error) | uint64_t(code));
+    _error = EErrorCode(uint64_t(EErrorCode(_error)) | uint64_t(code));
 }
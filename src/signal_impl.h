@@ -5,12 +5,28 @@
 
 #include <dbcppp-tiny/signal.h>
 #include <dbcppp-tiny/node.h>
+#include <dbcppp-tiny/static_signal.h>
 #include "attribute_impl.h"
 #include "signal_multiplexer_value_impl.h"
 #include "value_encoding_description_impl.h"
+#include "arena.h"
+#include "cpu_features.h"
+#include "descriptor_types.h"
+#include "string_pool.h"
 
 namespace dbcppp
 {
+    // kernel family the signal's decode function is taken from
+    enum class DecodeKernel
+    {
+        // shift/mask template_decode instantiations, available everywhere
+        Template,
+        // BMI2 pext instantiations for signals readable with one 64 bit load
+        Pext
+    };
+
+    class IMessage;
+
     class SignalImpl final
         : public ISignal
     {
@@ -30,10 +46,10 @@ namespace dbcppp
             , double maximum
             , std::string&& unit
             , std::vector<std::string>&& receivers
-            , std::vector<AttributeImpl>&& attribute_values
-            , std::vector<ValueEncodingDescriptionImpl>&& value_encoding_descriptions
+            , ArenaVector<AttributeImpl>&& attribute_values
+            , ArenaVector<ValueEncodingDescriptionImpl>&& value_encoding_descriptions
             , EExtendedValueType extended_value_type
-            , std::vector<SignalMultiplexerValueImpl>&& signal_multiplexer_values);
+            , ArenaVector<SignalMultiplexerValueImpl>&& signal_multiplexer_values);
             
         virtual const std::string& Name() const override;
         virtual EMultiplexer MultiplexerIndicator() const override;
@@ -51,43 +67,63 @@ namespace dbcppp
         virtual uint64_t Receivers_Size() const override;
         virtual const IValueEncodingDescription& ValueEncodingDescriptions_Get(std::size_t i) const override;
         virtual uint64_t ValueEncodingDescriptions_Size() const override;
+        virtual ObjectSpan<IValueEncodingDescription> ValueEncodingDescriptions() const override;
         virtual const IAttribute& AttributeValues_Get(std::size_t i) const override;
         virtual uint64_t AttributeValues_Size() const override;
+        virtual ObjectSpan<IAttribute> AttributeValues() const override;
         virtual EExtendedValueType ExtendedValueType() const override;
         virtual const ISignalMultiplexerValue& SignalMultiplexerValues_Get(std::size_t i) const override;
         virtual uint64_t SignalMultiplexerValues_Size() const override;
+        virtual ObjectSpan<ISignalMultiplexerValue> SignalMultiplexerValues() const override;
         virtual bool Error(EErrorCode code) const override;
-        
+        virtual void DecodeBatch(const void* frames, std::size_t stride, std::size_t n, raw_t* out) const noexcept override;
+        virtual void DecodeBatch(const void* frames, std::size_t stride, std::size_t n, double* out) const noexcept override;
+
+        // switches the decode function, returns false and keeps the templates if the kernel can't be used
+        // for this signal or CPU. Signals select Pext on construction when the CPU has a fast pext.
+        bool SelectDecodeKernel(DecodeKernel kernel) noexcept;
+        DecodeKernel SelectedDecodeKernel() const noexcept;
+        // message the signal is stored in, kept up to date by MessageImpl; nullptr for a standalone signal
+        const IMessage* Message() const noexcept;
+        void SetMessage(const IMessage* message) noexcept;
+
+        // Hot: everything the decode and raw_to_phys functions read, declared first so it
+        // shares the object's first cache line with the function pointers of ISignal.
+        // The descriptive members below are only touched by the getters.
+        uint64_t _mask;
+#ifdef DBCPPP_X86_DISPATCH
+        // _mask << _fixed_start_bit_0 for the pext kernels
+        uint64_t _pext_mask;
+#endif
+        scale_t _factor;
+        scale_t _offset;
+        byte_pos_t _byte_pos;
+        // shift counts are stored modulo 64, values that don't fit only occur for signals with an error
+        uint8_t _fixed_start_bit_0;
+        uint8_t _fixed_start_bit_1;
+        // 64 - _bit_size
+        uint8_t _sign_shift;
+        Alignment _alignment;
 
     private:
         void SetError(EErrorCode code);
 
         std::string _name;
-        EMultiplexer _multiplexer_indicator;
         uint64_t _multiplexer_switch_value;
-        uint64_t _start_bit;
-        uint64_t _bit_size;
-        EByteOrder _byte_order;
-        EValueType _value_type;
-        double _factor;
-        double _offset;
-        double _minimum;
-        double _maximum;
-        std::string _unit;
-        std::vector<std::string> _receivers;
-        std::vector<AttributeImpl> _attribute_values;
-        std::vector<ValueEncodingDescriptionImpl> _value_encoding_descriptions;
-        EExtendedValueType _extended_value_type;
-        std::vector<SignalMultiplexerValueImpl> _signal_multiplexer_values;
-
-    public:
-        // for performance
-        uint64_t _mask;
-        uint64_t _mask_signed;
-        uint64_t _fixed_start_bit_0;
-        uint64_t _fixed_start_bit_1;
-        uint64_t _byte_pos;
-
-        EErrorCode _error;
+        scale_t _minimum;
+        scale_t _maximum;
+        bit_pos_t _start_bit;
+        bit_pos_t _bit_size;
+        enum_storage_t<EMultiplexer> _multiplexer_indicator;
+        enum_storage_t<EByteOrder> _byte_order;
+        enum_storage_t<EValueType> _value_type;
+        enum_storage_t<EExtendedValueType> _extended_value_type;
+        enum_storage_t<EErrorCode> _error;
+        PooledString _unit;
+        ArenaVector<PooledString> _receivers;
+        ArenaVector<AttributeImpl> _attribute_values;
+        ArenaVector<ValueEncodingDescriptionImpl> _value_encoding_descriptions;
+        ArenaVector<SignalMultiplexerValueImpl> _signal_multiplexer_values;
+        const IMessage* _message;
     };
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ SignalMultiplexerValueImpl::SignalMultiplexerValueImpl(
     , std::vector<Range>&& value_ranges)
 
     : _switch_name(std::move(switch_name))
-    , _value_ranges(std::move(value_ranges))
+    , _value_ranges(value_ranges.begin(), value_ranges.end())
 {}
             
 
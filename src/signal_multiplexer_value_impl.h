@@ -2,6 +2,7 @@
 #pragma once
 
 #include <dbcppp-tiny/signal_multiplexer_value.h>
+#include "arena.h"
 
 namespace dbcppp
 {
@@ -19,6 +20,6 @@ namespace dbcppp
 
     private:
         std::string _switch_name;
-        std::vector<Range> _value_ranges;
+        ArenaVector<Range> _value_ranges;
     };
 }
@@ -0,0 +1,46 @@
+#include "snapshot_view_impl.h"
+
+using namespace dbcppp;
+
+std::unique_ptr<ISnapshotView> ISnapshotView::Open(std::string_view data)
+{
+    NetworkSnapshot snapshot;
+    if (!snapshot.Open(data))
+    {
+        return nullptr;
+    }
+    return std::make_unique<SnapshotViewImpl>(snapshot);
+}
+SnapshotViewImpl::SnapshotViewImpl(const NetworkSnapshot& snapshot)
+    : _snapshot(snapshot)
+{}
+uint64_t SnapshotViewImpl::Messages_Size() const noexcept
+{
+    return _snapshot.Count(snapshot::Messages);
+}
+std::size_t SnapshotViewImpl::FindMessage(uint64_t id) const noexcept
+{
+    const snapshot::Message* msg = _snapshot.FindMessage(id);
+    return msg ? std::size_t(msg - &Message(0)) : npos;
+}
+uint64_t SnapshotViewImpl::MessageId(std::size_t i) const noexcept
+{
+    return Message(i).id;
+}
+std::string_view SnapshotViewImpl::MessageName(std::size_t i) const noexcept
+{
+    return _snapshot.String(Message(i).name);
+}
+uint64_t SnapshotViewImpl::Signals_Size(std::size_t i) const noexcept
+{
+    return Message(i).signals.count;
+}
+std::string_view SnapshotViewImpl::SignalName(std::size_t i, std::size_t j) const noexcept
+{
+    const snapshot::Signal* signals = _snapshot.Records<snapshot::Signal>(snapshot::Signals);
+    return _snapshot.String(signals[Message(i).signals.first + j].name);
+}
+std::size_t SnapshotViewImpl::DecodeAll(std::size_t i, const void* bytes, std::size_t len, double* out) const noexcept
+{
+    return _snapshot.DecodeAll(Message(i), bytes, len, out);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "dbcppp-tiny/snapshot_view.h"
+#include "network_snapshot.h"
+
+namespace dbcppp
+{
+    class SnapshotViewImpl final
+        : public ISnapshotView
+    {
+    public:
+        explicit SnapshotViewImpl(const NetworkSnapshot& snapshot);
+
+        virtual uint64_t Messages_Size() const noexcept override;
+        virtual std::size_t FindMessage(uint64_t id) const noexcept override;
+        virtual uint64_t MessageId(std::size_t i) const noexcept override;
+        virtual std::string_view MessageName(std::size_t i) const noexcept override;
+        virtual uint64_t Signals_Size(std::size_t i) const noexcept override;
+        virtual std::string_view SignalName(std::size_t i, std::size_t j) const noexcept override;
+        virtual std::size_t DecodeAll(std::size_t i, const void* bytes, std::size_t len, double* out) const noexcept override;
+
+    private:
+        const snapshot::Message& Message(std::size_t i) const noexcept
+        {
+            return _snapshot.Records<snapshot::Message>(snapshot::Messages)[i];
+        }
+
+        NetworkSnapshot _snapshot;
+    };
+}
@@ -0,0 +1,44 @@
+#include "string_pool.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    thread_local StringPool* current_pool = nullptr;
+}
+
+const std::string& StringPool::Intern(std::string_view str)
+{
+    auto iter = _lookup.find(str);
+    if (iter != _lookup.end())
+    {
+        return *iter->second;
+    }
+    const std::string& result = _strings.emplace_back(str);
+    _lookup.emplace(result, &result);
+    return result;
+}
+void StringPool::Freeze()
+{
+    std::unordered_map<std::string_view, const std::string*>().swap(_lookup);
+}
+StringPool* StringPool::Current() noexcept
+{
+    return current_pool;
+}
+
+StringPoolScope::StringPoolScope(StringPool& pool) noexcept
+    : _previous(current_pool)
+{
+    current_pool = &pool;
+}
+StringPoolScope::~StringPoolScope()
+{
+    current_pool = _previous;
+}
+
+const std::string& PooledString::Empty() noexcept
+{
+    static const std::string empty;
+    return empty;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "arena.h"
+
+namespace dbcppp
+{
+    // Set of unique strings with stable addresses. Receivers, units, node and attribute names
+    // repeat thousands of times in a DBC, a network stores each of them once in its pool and
+    // refers to it through PooledString.
+    //
+    // Like Arena, the pool strings are interned into is selected per thread: while a
+    // StringPoolScope is active (the network is being built), the scope's pool is used.
+    // Outside of any scope there is no pool, PooledString owns its string then.
+    class StringPool
+    {
+    public:
+        StringPool() = default;
+        StringPool(const StringPool&) = delete;
+        StringPool& operator=(const StringPool&) = delete;
+
+        const std::string& Intern(std::string_view str);
+
+        // Drops the lookup table once no more strings are added, the strings stay valid
+        void Freeze();
+        std::size_t Size() const noexcept
+        {
+            return _strings.size();
+        }
+
+        // pool of the innermost StringPoolScope on this thread or nullptr
+        static StringPool* Current() noexcept;
+
+    private:
+        std::deque<std::string, ArenaAllocator<std::string>> _strings;
+        std::unordered_map<std::string_view, const std::string*> _lookup;
+    };
+
+    class StringPoolScope
+    {
+    public:
+        explicit StringPoolScope(StringPool& pool) noexcept;
+        ~StringPoolScope();
+        StringPoolScope(const StringPoolScope&) = delete;
+        StringPoolScope& operator=(const StringPoolScope&) = delete;
+
+    private:
+        StringPool* _previous;
+    };
+
+    // Handle to a pooled string, a pointer instead of a std::string. Constructing or
+    // copying a handle interns into the current pool. Outside of any StringPoolScope (objects
+    // created through the public Create() functions or copied out of a network) the handle
+    // owns a heap copy of its string instead, freed with the handle. Moves keep the pointer,
+    // which follows the rules of ArenaAllocator: objects copied out of a network don't
+    // depend on it.
+    class PooledString
+    {
+    public:
+        PooledString() noexcept
+            : _str(&Empty())
+        {}
+        PooledString(std::string_view str)
+            : _str(Make(str))
+            , _owned(StringPool::Current() == nullptr)
+        {}
+        PooledString(const PooledString& other)
+            : PooledString(std::string_view(*other._str))
+        {}
+        PooledString(PooledString&& other) noexcept
+            : _str(other._str)
+            , _owned(other._owned)
+        {
+            other._str = &Empty();
+            other._owned = false;
+        }
+        PooledString& operator=(const PooledString& other)
+        {
+            if (this != &other)
+            {
+                PooledString copy(other);
+                Swap(copy);
+            }
+            return *this;
+        }
+        PooledString& operator=(PooledString&& other) noexcept
+        {
+            PooledString moved(std::move(other));
+            Swap(moved);
+            return *this;
+        }
+        ~PooledString()
+        {
+            if (_owned)
+            {
+                delete _str;
+            }
+        }
+
+        const std::string& Get() const noexcept
+        {
+            return *_str;
+        }
+        operator const std::string&() const noexcept
+        {
+            return *_str;
+        }
+
+    private:
+        static const std::string* Make(std::string_view str)
+        {
+            StringPool* pool = StringPool::Current();
+            return pool ? &pool->Intern(str) : new std::string(str);
+        }
+        void Swap(PooledString& other) noexcept
+        {
+            std::swap(_str, other._str);
+            std::swap(_owned, other._owned);
+        }
+        static const std::string& Empty() noexcept;
+
+        const std::string* _str;
+        bool _owned = false;
+    };
+}
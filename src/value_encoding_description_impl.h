@@ -3,6 +3,7 @@
 
 #include <string>
 #include <dbcppp-tiny/value_encoding_description.h>
+#include "string_pool.h"
 
 namespace dbcppp
 {
@@ -16,6 +17,6 @@ namespace dbcppp
 
     private:
         int64_t _value;
-        std::string _description;
+        PooledString _description;
     };
 }
@@ -10,7 +10,8 @@ std::unique_ptr<IValueTable> IValueTable::Create(
     , std::vector<std::unique_ptr<IValueEncodingDescription>>&& value_encoding_descriptions)
 {
     std::optional<SignalTypeImpl> st;
-    std::vector<ValueEncodingDescriptionImpl> veds;
+    ArenaVector<ValueEncodingDescriptionImpl> veds;
+    veds.reserve(value_encoding_descriptions.size());
     veds.reserve(value_encoding_descriptions.size());
     if (signal_type)
     {
@@ -27,7 +28,7 @@ std::unique_ptr<IValueTable> IValueTable::Create(
 ValueTableImpl::ValueTableImpl(
       std::string&& name
     , std::optional<SignalTypeImpl>&& signal_type
-    , std::vector<ValueEncodingDescriptionImpl>&& value_encoding_descriptions)
+    , ArenaVector<ValueEncodingDescriptionImpl>&& value_encoding_descriptions)
 
     : _name(std::move(name))
     , _signal_type(std::move(signal_type))
@@ -8,10 +8,10 @@
 #include "dbcppp-tiny/value_table.h"
 #include "signal_type_impl.h"
 #include "value_encoding_description_impl.h"
+#include "arena.h"
 
 namespace dbcppp
 {
-    class SignalType;
     class ValueTableImpl final
         : public IValueTable
     {
@@ -19,7 +19,7 @@ namespace dbcppp
         ValueTableImpl(
               std::string&& name
             , std::optional<SignalTypeImpl>&& signal_type
-            , std::vector<ValueEncodingDescriptionImpl>&& value_encoding_descriptions);
+            , ArenaVector<ValueEncodingDescriptionImpl>&& value_encoding_descriptions);
 
         virtual const std::string& Name() const override;
         virtual std::optional<std::reference_wrapper<const ISignalType>> SignalType() const override;
@@ -29,6 +29,6 @@ namespace dbcppp
     private:
         std::string _name;
         std::optional<SignalTypeImpl> _signal_type;
-        std::vector<ValueEncodingDescriptionImpl> _value_encoding_descriptions;
+        ArenaVector<ValueEncodingDescriptionImpl> _value_encoding_descriptions;
     };
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 #include <dbcppp-tiny/network.h>
+#include "../src/signal_impl.h"
 
 using namespace dbcppp;
 
@@ -133,3 +138,315 @@ TEST_CASE("API Test: Message", "[unit]")
         REQUIRE(net->Messages_Get(0).Signals_Size() == 3);
     }
 }
+TEST_CASE("API Test: Iteration", "[unit]")
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 1 Msg0: 8 Sender0\n"
+        "  SG_ Sig0: 0|1@1+ (1,0) [1|12] \"Unit0\" Recv0, Recv1, Recv2\n"
+        "  SG_ Sig1: 1|1@1+ (1,0) [1|12] \"Unit1\" Vector__XXX\n"
+        "  SG_ Sig2: 2|1@1+ (1,0) [1|12] \"Unit2\" Vector__XXX\n"
+        "BO_ 2 Msg1: 8 Sender0\n";
+
+    auto net = INetwork::LoadDBCFromString(test_dbc);
+    REQUIRE(net);
+
+    SECTION("Object spans")
+    {
+        auto messages = net->Messages();
+        REQUIRE(messages.size() == 2);
+        REQUIRE(&messages[1] == &net->Messages_Get(1));
+        auto sigs = messages.front().Signals();
+        REQUIRE(sigs.size() == 3);
+        REQUIRE(!sigs.empty());
+        REQUIRE(std::distance(sigs.begin(), sigs.end()) == 3);
+        std::vector<std::string> names;
+        for (const ISignal& sig : sigs)
+        {
+            names.push_back(sig.Name());
+        }
+        REQUIRE(names == std::vector<std::string>{"Sig0", "Sig1", "Sig2"});
+        auto last = sigs.end() - 1;
+        REQUIRE(&*last == &sigs.back());
+        REQUIRE(last->Name() == "Sig2");
+        REQUIRE(last - sigs.begin() == 2);
+        REQUIRE((sigs.begin() + 1)->Name() == "Sig1");
+        REQUIRE(sigs.begin()[1].Name() == "Sig1");
+        REQUIRE(sigs.begin() < last);
+        REQUIRE(--sigs.end() == last);
+        REQUIRE(messages.back().Signals().empty());
+        REQUIRE(messages.back().Signals().begin() == messages.back().Signals().end());
+    }
+    SECTION("Iterators")
+    {
+        auto receivers = net->Messages_Get(0).Signals_Get(0).Receivers();
+        auto first = receivers.begin();
+        auto last = receivers.end() - 1;
+        REQUIRE(receivers.end() - first == 3);
+        REQUIRE(*last == "Recv2");
+        REQUIRE(*(last - 2) == "Recv0");
+        REQUIRE(first[1] == "Recv1");
+        REQUIRE(first < last);
+        REQUIRE(std::find(receivers.begin(), receivers.end(), "Recv1") - first == 1);
+    }
+}
+TEST_CASE("API Test: FindMessage", "[unit]")
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_:\n"
+        "BO_ 1 Msg0: 8 Sender0\n"
+        "  SG_ Sig0: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 2047 Msg1: 8 Sender0\n"
+        "  SG_ Sig0: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 2147483649 Msg2: 8 Sender0\n"
+        "  SG_ Sig0: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 2566844926 Msg3: 8 Sender0\n"
+        "  SG_ Sig0: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 1 Msg4: 8 Sender0\n"
+        "  SG_ Sig0: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+
+    SECTION("CPP API")
+    {
+        auto net = INetwork::LoadDBCFromString(test_dbc);
+        REQUIRE(net);
+
+        REQUIRE(net->FindMessage(1));
+        REQUIRE(net->FindMessage(1)->Name() == "Msg0");
+        REQUIRE(net->FindMessage(2047));
+        REQUIRE(net->FindMessage(2047)->Name() == "Msg1");
+        REQUIRE(net->FindMessage(0x80000001));
+        REQUIRE(net->FindMessage(0x80000001)->Name() == "Msg2");
+        REQUIRE(net->FindMessage(0x98FEF1FE));
+        REQUIRE(net->FindMessage(0x98FEF1FE)->Name() == "Msg3");
+
+        REQUIRE(net->FindMessage(0) == nullptr);
+        REQUIRE(net->FindMessage(2) == nullptr);
+        REQUIRE(net->FindMessage(2048) == nullptr);
+        REQUIRE(net->FindMessage(0x80000002) == nullptr);
+        REQUIRE(net->FindMessage(0x18FEF1FE) == nullptr);
+    }
+    SECTION("Many extended IDs")
+    {
+        std::string dbc = "VERSION \"\"\nNS_ :\nBS_:\nBU_:\n";
+        for (uint64_t i = 0; i < 1000; i++)
+        {
+            uint64_t id = 0x80000000 | (i * 0x10001);
+            dbc += "BO_ " + std::to_string(id) + " Msg" + std::to_string(i) + ": 8 Sender0\n";
+        }
+        auto net = INetwork::LoadDBCFromString(dbc);
+        REQUIRE(net);
+        REQUIRE(net->Messages_Size() == 1000);
+        for (uint64_t i = 0; i < 1000; i++)
+        {
+            const IMessage* msg = net->FindMessage(0x80000000 | (i * 0x10001));
+            REQUIRE(msg);
+            REQUIRE(msg == &net->Messages_Get(i));
+        }
+        REQUIRE(net->FindMessage(0x80000000 | 0x10000) == nullptr);
+    }
+}
+TEST_CASE("API Test: ParentMessage", "[unit]")
+{
+    std::string dbc = "VERSION \"\"\nNS_ :\nBS_:\nBU_:\n";
+    for (uint64_t i = 0; i < 100; i++)
+    {
+        dbc += "BO_ " + std::to_string(i) + " Msg" + std::to_string(i) + ": 8 Sender0\n";
+        for (uint64_t j = 0; j < i % 5; j++)
+        {
+            dbc += "  SG_ Sig" + std::to_string(j) + ": " + std::to_string(8 * j) + "|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+        }
+    }
+    auto net = INetwork::LoadDBCFromString(dbc);
+    REQUIRE(net);
+    REQUIRE(net->Messages_Size() == 100);
+    for (const IMessage& msg : net->Messages())
+    {
+        for (const ISignal& sig : msg.Signals())
+        {
+            REQUIRE(net->ParentMessage(&sig) == &msg);
+        }
+    }
+    REQUIRE(net->ParentMessage(nullptr) == nullptr);
+
+    // signals of another network aren't found
+    auto other = INetwork::LoadDBCFromString(dbc);
+    REQUIRE(other);
+    REQUIRE(net->ParentMessage(&other->Messages_Get(1).Signals_Get(0)) == nullptr);
+    REQUIRE(other->ParentMessage(&other->Messages_Get(1).Signals_Get(0)) == &other->Messages_Get(1));
+}
+TEST_CASE("API Test: Find by name", "[unit]")
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: Node0 Node1\n"
+        "BO_ 1 Msg0: 8 Node0\n"
+        "  SG_ Speed: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "  SG_ Gear: 8|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 2 Msg1: 8 Node1\n"
+        "  SG_ Torque: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 3 Msg2: 8 Node1\n"
+        "  SG_ Speed: 8|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 4 Msg0: 8 Node1\n";
+
+    auto net = INetwork::LoadDBCFromString(test_dbc);
+    REQUIRE(net);
+
+    SECTION("Messages")
+    {
+        REQUIRE(net->FindMessageByName("Msg1") == &net->Messages_Get(1));
+        REQUIRE(net->FindMessageByName("Msg2") == &net->Messages_Get(2));
+        // the first of equally named messages
+        REQUIRE(net->FindMessageByName("Msg0") == &net->Messages_Get(0));
+        REQUIRE(net->FindMessageByName("Msg") == nullptr);
+        REQUIRE(net->FindMessageByName("") == nullptr);
+    }
+    SECTION("Nodes")
+    {
+        REQUIRE(net->FindNode("Node1"));
+        REQUIRE(net->FindNode("Node1")->Name() == "Node1");
+        REQUIRE(net->FindNode("Node2") == nullptr);
+    }
+    SECTION("Signals")
+    {
+        auto speed = net->FindSignal("Speed");
+        REQUIRE(speed.size() == 2);
+        REQUIRE(speed[0].message == &net->Messages_Get(0));
+        REQUIRE(speed[0].signal == &net->Messages_Get(0).Signals_Get(0));
+        REQUIRE(speed[1].message == &net->Messages_Get(2));
+        REQUIRE(speed[1].signal == &net->Messages_Get(2).Signals_Get(0));
+        auto torque = net->FindSignal("Torque");
+        REQUIRE(torque.size() == 1);
+        REQUIRE(torque.front().signal->Name() == "Torque");
+        REQUIRE(torque.front().message->Name() == "Msg1");
+        REQUIRE(net->FindSignal("Speed2").empty());
+    }
+    SECTION("Many names")
+    {
+        std::string dbc = "VERSION \"\"\nNS_ :\nBS_:\nBU_:\n";
+        for (uint64_t i = 0; i < 1000; i++)
+        {
+            dbc += "BO_ " + std::to_string(i) + " Msg" + std::to_string(i) + ": 8 Sender0\n";
+            dbc += "  SG_ Sig" + std::to_string(i) + ": 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+            dbc += "  SG_ Common: 8|8@1+ (1,0) [0|0] \"\" Vector__XXX\n";
+        }
+        auto many = INetwork::LoadDBCFromString(dbc);
+        REQUIRE(many);
+        for (uint64_t i = 0; i < 1000; i++)
+        {
+            REQUIRE(many->FindMessageByName("Msg" + std::to_string(i)) == &many->Messages_Get(i));
+            auto sig = many->FindSignal("Sig" + std::to_string(i));
+            REQUIRE(sig.size() == 1);
+            REQUIRE(sig.front().signal == &many->Messages_Get(i).Signals_Get(0));
+        }
+        auto common = many->FindSignal("Common");
+        REQUIRE(common.size() == 1000);
+        for (uint64_t i = 0; i < 1000; i++)
+        {
+            REQUIRE(common[i].message == &many->Messages_Get(i));
+            REQUIRE(common[i].signal->Name() == "Common");
+        }
+    }
+}
+TEST_CASE("API Test: Attribute index", "[unit]")
+{
+    constexpr const char* test_dbc =
+        "VERSION \"\"\n"
+        "NS_ :\n"
+        "BS_:\n"
+        "BU_: Node0 Node1\n"
+        "BO_ 1 Msg0: 8 Node0\n"
+        "  SG_ Sig0: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "  SG_ Sig1: 8|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BO_ 2 Msg1: 8 Node1\n"
+        "  SG_ Sig0: 0|8@1+ (1,0) [0|0] \"\" Vector__XXX\n"
+        "BA_DEF_  \"BusType\" STRING ;\n"
+        "BA_DEF_ BU_  \"NmStationAddress\" HEX 0 255;\n"
+        "BA_DEF_ BO_  \"GenMsgCycleTime\" INT 0 3600000;\n"
+        "BA_DEF_ BO_  \"VFrameFormat\" ENUM  \"StandardCAN\",\"ExtendedCAN\",\"J1939PG\";\n"
+        "BA_DEF_ SG_  \"GenSigStartValue\" FLOAT 0 100000;\n"
+        "BA_DEF_ BO_  \"GenMsgNoDefault\" INT 0 10;\n"
+        "BA_DEF_DEF_  \"BusType\" \"CAN\";\n"
+        "BA_DEF_DEF_  \"NmStationAddress\" 0;\n"
+        "BA_DEF_DEF_  \"GenMsgCycleTime\" 100;\n"
+        "BA_DEF_DEF_  \"VFrameFormat\" \"ExtendedCAN\";\n"
+        "BA_DEF_DEF_  \"GenSigStartValue\" 1.5;\n"
+        "BA_ \"NmStationAddress\" BU_ Node1 2;\n"
+        "BA_ \"GenMsgCycleTime\" BO_ 2 20;\n"
+        "BA_ \"VFrameFormat\" BO_ 2 2;\n"
+        "BA_ \"GenSigStartValue\" SG_ 1 Sig1 7.25;\n";
+
+    auto net = INetwork::LoadDBCFromString(test_dbc);
+    REQUIRE(net);
+    REQUIRE(net->Messages_Size() == 2);
+
+    std::size_t bus_type = net->AttributeId("BusType");
+    std::size_t station = net->AttributeId("NmStationAddress");
+    std::size_t cycle_time = net->AttributeId("GenMsgCycleTime");
+    std::size_t frame_format = net->AttributeId("VFrameFormat");
+    std::size_t start_value = net->AttributeId("GenSigStartValue");
+    std::size_t no_default = net->AttributeId("GenMsgNoDefault");
+    REQUIRE(cycle_time != INetwork::npos);
+    REQUIRE(net->AttributeDefinitions_Get(cycle_time).Name() == "GenMsgCycleTime");
+    REQUIRE(net->AttributeId("GenMsgCycleTim") == INetwork::npos);
+
+    const IMessage& msg0 = net->Messages_Get(0);
+    const IMessage& msg1 = net->Messages_Get(1);
+
+    SECTION("Values and defaults")
+    {
+        REQUIRE(net->GetAttributeInt(msg0, cycle_time) == 100);
+        REQUIRE(net->GetAttributeInt(msg1, cycle_time) == 20);
+        REQUIRE(net->GetAttributeDouble(msg1, cycle_time) == 20.0);
+        REQUIRE(!net->GetAttributeInt(msg0, no_default));
+        REQUIRE(net->GetAttribute(msg0, no_default) == nullptr);
+
+        REQUIRE(net->GetAttributeDouble(msg0.Signals_Get(0), start_value) == 1.5);
+        REQUIRE(net->GetAttributeDouble(msg0.Signals_Get(1), start_value) == 7.25);
+        REQUIRE(net->GetAttributeDouble(msg1.Signals_Get(0), start_value) == 1.5);
+
+        REQUIRE(net->GetAttributeInt(net->Nodes()[0], station) == 0);
+        REQUIRE(net->GetAttributeInt(net->Nodes()[1], station) == 2);
+
+        REQUIRE(net->GetAttributeString(*net, bus_type));
+        REQUIRE(*net->GetAttributeString(*net, bus_type) == "CAN");
+    }
+    SECTION("Enums")
+    {
+        // the default is given by name, reads return the index like for BA_ values
+        REQUIRE(net->GetAttributeInt(msg0, frame_format) == 1);
+        REQUIRE(*net->GetAttributeString(msg0, frame_format) == "ExtendedCAN");
+        REQUIRE(net->GetAttributeInt(msg1, frame_format) == 2);
+        REQUIRE(*net->GetAttributeString(msg1, frame_format) == "J1939PG");
+    }
+    SECTION("Mismatches")
+    {
+        // attributes of another object type
+        REQUIRE(net->GetAttribute(msg0, start_value) == nullptr);
+        REQUIRE(net->GetAttribute(msg0.Signals_Get(0), cycle_time) == nullptr);
+        REQUIRE(net->GetAttribute(msg0, INetwork::npos) == nullptr);
+        REQUIRE(!net->GetAttributeDouble(msg0, bus_type));
+        REQUIRE(net->GetAttributeString(msg0, cycle_time) == nullptr);
+
+        // objects of another network
+        auto other = INetwork::LoadDBCFromString(test_dbc);
+        REQUIRE(other);
+        REQUIRE(net->GetAttribute(other->Messages_Get(0), cycle_time) == nullptr);
+        REQUIRE(net->GetAttribute(other->Messages_Get(0).Signals_Get(0), start_value) == nullptr);
+        REQUIRE(net->GetAttribute(other->Nodes()[0], station) == nullptr);
+        REQUIRE(net->GetAttribute(*other, bus_type) == nullptr);
+        REQUIRE(other->GetAttributeInt(other->Messages_Get(1), cycle_time) == 20);
+
+        // a copy keeps the back-reference to its message but isn't one of its signals
+        SignalImpl copy = static_cast<const SignalImpl&>(msg0.Signals_Get(0));
+        REQUIRE(net->ParentMessage(&copy) == &msg0);
+        REQUIRE(net->GetAttribute(copy, start_value) == nullptr);
+    }
+}
@@ -0,0 +1,135 @@
+// Benchmark comparing the shift/mask decode templates with the BMI2 pext kernels
+// and the per-message (portable and JIT compiled)/batch decode paths, on randomly placed signals.
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <string>
+
+#include "dbcppp-tiny/network.h"
+#include "../src/signal_impl.h"
+#include "../src/cpu_features.h"
+#include "../src/message_impl.h"
+#include "../src/decode_jit.h"
+
+using namespace dbcppp;
+
+static std::vector<std::unique_ptr<ISignal>> make_signals(std::size_t n, ISignal::EByteOrder byte_order, std::mt19937& rng)
+{
+    std::vector<std::unique_ptr<ISignal>> signals;
+    while (signals.size() < n)
+    {
+        uint64_t bit_size = rng() % 32 + 1;
+        uint64_t start_bit = rng() % 64;
+        auto value_type = rng() % 2 ? ISignal::EValueType::Signed : ISignal::EValueType::Unsigned;
+        auto sig = ISignal::Create(8, "Sig" + std::to_string(signals.size()), ISignal::EMultiplexer::NoMux, 0,
+            start_bit, bit_size, byte_order, value_type, 0.5, 1.0, 0.0, 0.0, "", {}, {}, {},
+            ISignal::EExtendedValueType::Integer, {});
+        if (sig->Error(ISignal::EErrorCode::NoError))
+        {
+            signals.push_back(std::move(sig));
+        }
+    }
+    return signals;
+}
+
+template <class F>
+static double measure(std::size_t iterations, F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        f(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t n_frames = argc > 1 ? std::stoul(argv[1]) : 4096;
+    std::size_t n_rounds = argc > 2 ? std::stoul(argv[2]) : 200;
+
+    std::mt19937 rng(42);
+    std::vector<uint8_t> frames(n_frames * 8);
+    for (auto& b : frames)
+    {
+        b = uint8_t(rng());
+    }
+
+    std::cout << "BMI2 supported: " << (CpuSupportsBmi2() ? "yes" : "no")
+              << ", fast pext: " << (CpuHasFastPext() ? "yes" : "no") << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (auto byte_order : {ISignal::EByteOrder::LittleEndian, ISignal::EByteOrder::BigEndian})
+    {
+        auto signals = make_signals(48, byte_order, rng);
+        const char* name = byte_order == ISignal::EByteOrder::LittleEndian ? "Intel   " : "Motorola";
+
+        uint64_t checksum[2] = {0, 0};
+        for (auto kernel : {DecodeKernel::Template, DecodeKernel::Pext})
+        {
+            bool available = true;
+            for (auto& sig : signals)
+            {
+                available &= static_cast<SignalImpl&>(*sig).SelectDecodeKernel(kernel);
+            }
+            if (!available)
+            {
+                std::cout << name << " pext kernel not available\n";
+                continue;
+            }
+            uint64_t& sum = checksum[int(kernel)];
+            double ns = measure(n_rounds * n_frames, [&](std::size_t i)
+                {
+                    const uint8_t* frame = &frames[(i % n_frames) * 8];
+                    for (const auto& sig : signals)
+                    {
+                        sum += sig->Decode(frame);
+                    }
+                });
+            std::cout << name << " " << (kernel == DecodeKernel::Template ? "template" : "pext    ")
+                      << ": " << ns / signals.size() << " ns/signal\n";
+        }
+        if (checksum[1] != 0 && checksum[0] != checksum[1])
+        {
+            std::cerr << "checksum mismatch between template and pext kernels!\n";
+            return 1;
+        }
+
+        auto msg = IMessage::Create(1, "Msg", 8, "", {}, std::move(signals), {}, {});
+        std::vector<double> values(msg->Signals_Size());
+        double sum = 0;
+        double ns = measure(n_rounds * n_frames, [&](std::size_t i)
+            {
+                msg->DecodeAll(&frames[(i % n_frames) * 8], 8, values.data());
+                sum += values[0];
+            });
+        std::cout << name << " DecodeAll: " << ns / msg->Signals_Size() << " ns/signal (" << sum << ")\n";
+        DecodePlan& plan = static_cast<MessageImpl&>(*msg).decodePlan();
+        DecodeJit jit;
+        if (jit.Compile({&plan}))
+        {
+            plan.SetNative(jit.Entry(0));
+            ns = measure(n_rounds * n_frames, [&](std::size_t i)
+                {
+                    msg->DecodeAll(&frames[(i % n_frames) * 8], 8, values.data());
+                    sum += values[0];
+                });
+            plan.SetNative(nullptr);
+            std::cout << name << " DecodeAll JIT: " << ns / msg->Signals_Size() << " ns/signal (" << sum << ")\n";
+        }
+        std::vector<double> batch(n_frames);
+        ns = measure(n_rounds, [&](std::size_t)
+            {
+                for (const ISignal& sig : msg->Signals())
+                {
+                    sig.DecodeBatch(frames.data(), 8, n_frames, batch.data());
+                    sum += batch[0];
+                }
+            });
+        std::cout << name << " DecodeBatch: " << ns / (msg->Signals_Size() * n_frames) << " ns/signal (" << sum << ")\n";
+    }
+}
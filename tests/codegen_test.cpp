@@ -0,0 +1,112 @@
+#include <set>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "../include/dbcppp-tiny/network.h"
+
+// headers generated by dbc2cpp at build time, see CMakeLists.txt
+#include "codegen.h"
+#include "floating_point.h"
+#include "Model3CAN.h"
+
+#include "config.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    using decode_raw_t = std::size_t (*)(uint64_t, const uint8_t*, uint64_t*);
+    using decode_t = std::size_t (*)(uint64_t, const uint8_t*, double*);
+
+#ifndef DBCPPP_COMPACT_DESCRIPTORS
+    uint64_t bits_of(double v)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return bits;
+    }
+#endif
+    // every message of the DBC decoded by the generated switch has to match the runtime decoders
+    void check_against_runtime(const char* dbc, decode_raw_t decode_raw, decode_t decode)
+    {
+        using namespace dbcppp;
+
+        auto net = INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/dbc/" + dbc).c_str());
+        REQUIRE(net);
+        std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::set<uint64_t> ids;
+        for (std::size_t i = 0; i < net->Messages_Size(); i++)
+        {
+            const IMessage& msg = net->Messages_Get(i);
+            if (!ids.insert(msg.Id()).second)
+            {
+                continue;
+            }
+            std::vector<uint64_t> raw(msg.Signals_Size());
+            std::vector<double> values(msg.Signals_Size());
+            std::vector<double> expected(msg.Signals_Size());
+            for (std::size_t n = 0; n < 16; n++)
+            {
+                std::vector<uint8_t> data(64 + 16);
+                for (auto& b : data) b = uint8_t(byte(rng));
+                REQUIRE(decode_raw(msg.Id(), data.data(), raw.data()) == msg.Signals_Size());
+                REQUIRE(decode(msg.Id(), data.data(), values.data()) == msg.Signals_Size());
+                REQUIRE(msg.DecodeAll(data.data(), 64, expected.data()) == msg.Signals_Size());
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    const ISignal& sig = msg.Signals_Get(j);
+                    INFO(msg.Name() << "." << sig.Name());
+                    REQUIRE(raw[j] == sig.Decode(data.data()));
+#ifndef DBCPPP_COMPACT_DESCRIPTORS
+                    // compact descriptors scale in single precision, the generated code always in double
+                    REQUIRE(bits_of(values[j]) == bits_of(expected[j]));
+#endif
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Code generation")
+{
+    SECTION("Generated decoders match the runtime decoders")
+    {
+        check_against_runtime("codegen.dbc", gen_codegen::DecodeRaw, gen_codegen::Decode);
+        check_against_runtime("floating_point.dbc", gen_floating_point::DecodeRaw, gen_floating_point::Decode);
+        check_against_runtime("Model3CAN.dbc", gen_Model3CAN::DecodeRaw, gen_Model3CAN::Decode);
+    }
+    SECTION("Descriptors and names")
+    {
+        using namespace gen_codegen;
+
+        static_assert(Wide::id == 1 && Wide::size == 64 && Wide::signal_count == 7);
+        static_assert(Wide::Window_LE::descriptor.start_bit == 200 && Wide::Window_LE::descriptor.bit_size == 20);
+        static_assert(Wide::Window_LE::descriptor.factor == 0.25 && Wide::Window_LE::descriptor.offset == 10.0);
+        static_assert(Wide::Span_BE::descriptor.big_endian && !Wide::Span_BE::descriptor.is_signed);
+        static_assert(Wide::Double::descriptor.extended_value_type == 2);
+        // spanning signals read the byte after their 8 byte window
+        static_assert(Wide::extent > 16);
+
+        // names which aren't identifiers or collide with generated members are renamed
+        static_assert(Decode_2::id == 0x80000123ull);
+        static_assert(Decode_2::signal_count == 6);
+        REQUIRE(std::string(Decode_2::id_2::descriptor.name) == "id");
+        REQUIRE(std::string(Decode_2::default_::descriptor.name) == "default");
+        REQUIRE(std::string(Decode_2::default_::descriptor.unit) == "\"deg\"");
+        REQUIRE(std::string(Decode_2::Decode_3::descriptor.name) == "Decode");
+        REQUIRE(Decode_2::Value_0::descriptor.multiplexer == 2);
+        REQUIRE(Decode_2::Value_1::descriptor.multiplexer_switch_value == 1);
+
+        // raw values are compile time constants for constant frames
+        constexpr uint8_t frame[8] = {0x2A, 0x0F, 0x80, 0x00, 0, 0x01, 0x02, 0x03};
+        static_assert(Decode_2::id_2::Raw(frame) == 0x2A);
+        static_assert(Decode_2::default_::Raw(frame) == uint64_t(-1));
+        static_assert(Decode_2::Value_0::Raw(frame) == uint64_t(int64_t(-32768)));
+        static_assert(Decode_2::Decode_3::Raw(frame) == 0x030201);
+        REQUIRE(Decode(12345, frame, nullptr) == 0);
+    }
+}
@@ -3,10 +3,18 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <vector>
 
 #include "dbcppp-tiny/network.h"
+#include "dbcppp-tiny/snapshot_view.h"
 #include "../src/file_reader.h"
 #include "../src/dbc_stream_parser.h"
+#include "../src/mapped_file.h"
+#include "../src/network_snapshot.h"
+#include "../src/content_hash.h"
+#include "../src/network_impl.h"
+#include "../src/arena.h"
+#include "../src/string_pool.h"
 
 #include "config.h"
 
@@ -49,6 +57,592 @@ TEST_CASE("DBCParserTest", "[unit]")
     REQUIRE(success_count > 0);
 }
 
+TEST_CASE("Memory mapped DBC loading", "[unit]")
+{
+    SECTION("Mapped and read content are identical")
+    {
+        for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+        {
+            std::string path_str = dbc_file.path().string();
+            dbcppp::MappedFile mapped;
+            dbcppp::MappedFile read;
+            REQUIRE(mapped.open(path_str.c_str()));
+            REQUIRE(read.open(path_str.c_str(), false));
+            REQUIRE(!read.isMapped());
+            REQUIRE(mapped.view().size() == std::filesystem::file_size(dbc_file.path()));
+            REQUIRE(mapped.view() == read.view());
+        }
+    }
+    SECTION("LoadDBCFromFile matches line-by-line loading")
+    {
+        for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+        {
+            if (dbc_file.path().extension() != ".dbc")
+            {
+                continue;
+            }
+            std::string path_str = dbc_file.path().string();
+            INFO(path_str);
+            dbcppp::FileLineReader reader;
+            REQUIRE(reader.open(path_str.c_str()));
+            std::string content;
+            std::string line;
+            while (reader.readLine(line))
+            {
+                content += line + "\n";
+            }
+            auto from_file = dbcppp::INetwork::LoadDBCFromFile(path_str.c_str());
+            auto from_string = dbcppp::INetwork::LoadDBCFromString(content);
+            REQUIRE(bool(from_file) == bool(from_string));
+            if (!from_file)
+            {
+                continue;
+            }
+            REQUIRE(from_file->Messages_Size() == from_string->Messages_Size());
+            for (std::size_t i = 0; i < from_file->Messages_Size(); i++)
+            {
+                const auto& lhs = from_file->Messages_Get(i);
+                const auto& rhs = from_string->Messages_Get(i);
+                REQUIRE(lhs.Name() == rhs.Name());
+                REQUIRE(lhs.Signals_Size() == rhs.Signals_Size());
+                for (std::size_t j = 0; j < lhs.Signals_Size(); j++)
+                {
+                    REQUIRE(lhs.Signals_Get(j).Name() == rhs.Signals_Get(j).Name());
+                    REQUIRE(lhs.Signals_Get(j).Unit() == rhs.Signals_Get(j).Unit());
+                }
+            }
+        }
+    }
+    SECTION("Missing file")
+    {
+        dbcppp::MappedFile file;
+        REQUIRE(!file.open((std::string(TEST_FILES_PATH) + "/does_not_exist.dbc").c_str()));
+        REQUIRE(!file.isOpen());
+        REQUIRE(dbcppp::INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/does_not_exist.dbc").c_str()) == nullptr);
+    }
+}
+
+static void requireSameAttributes(const dbcppp::IAttribute& lhs, const dbcppp::IAttribute& rhs)
+{
+    REQUIRE(lhs.Name() == rhs.Name());
+    REQUIRE(lhs.ObjectType() == rhs.ObjectType());
+    REQUIRE(lhs.Value() == rhs.Value());
+}
+
+static void requireSameNetwork(const dbcppp::INetwork& lhs, const dbcppp::INetwork& rhs)
+{
+    REQUIRE(lhs.Version() == rhs.Version());
+    REQUIRE(lhs.NewSymbols_Size() == rhs.NewSymbols_Size());
+    REQUIRE(lhs.BitTiming().Baudrate() == rhs.BitTiming().Baudrate());
+    REQUIRE(lhs.Nodes_Size() == rhs.Nodes_Size());
+    for (std::size_t i = 0; i < lhs.Nodes_Size(); i++)
+    {
+        REQUIRE(lhs.Nodes_Get(i).Name() == rhs.Nodes_Get(i).Name());
+        REQUIRE(lhs.Nodes_Get(i).AttributeValues_Size() == rhs.Nodes_Get(i).AttributeValues_Size());
+    }
+    REQUIRE(lhs.ValueTables_Size() == rhs.ValueTables_Size());
+    for (std::size_t i = 0; i < lhs.ValueTables_Size(); i++)
+    {
+        REQUIRE(lhs.ValueTables_Get(i).Name() == rhs.ValueTables_Get(i).Name());
+        REQUIRE(lhs.ValueTables_Get(i).ValueEncodingDescriptions_Size() == rhs.ValueTables_Get(i).ValueEncodingDescriptions_Size());
+        REQUIRE(bool(lhs.ValueTables_Get(i).SignalType()) == bool(rhs.ValueTables_Get(i).SignalType()));
+    }
+    REQUIRE(lhs.AttributeDefinitions_Size() == rhs.AttributeDefinitions_Size());
+    for (std::size_t i = 0; i < lhs.AttributeDefinitions_Size(); i++)
+    {
+        REQUIRE(lhs.AttributeDefinitions_Get(i).Name() == rhs.AttributeDefinitions_Get(i).Name());
+        REQUIRE(lhs.AttributeDefinitions_Get(i).ValueType().index() == rhs.AttributeDefinitions_Get(i).ValueType().index());
+    }
+    REQUIRE(lhs.AttributeDefaults_Size() == rhs.AttributeDefaults_Size());
+    for (std::size_t i = 0; i < lhs.AttributeDefaults_Size(); i++)
+    {
+        requireSameAttributes(lhs.AttributeDefaults_Get(i), rhs.AttributeDefaults_Get(i));
+    }
+    REQUIRE(lhs.AttributeValues_Size() == rhs.AttributeValues_Size());
+    REQUIRE(lhs.Messages_Size() == rhs.Messages_Size());
+    for (std::size_t i = 0; i < lhs.Messages_Size(); i++)
+    {
+        const auto& lmsg = lhs.Messages_Get(i);
+        const auto& rmsg = rhs.Messages_Get(i);
+        REQUIRE(lmsg.Id() == rmsg.Id());
+        REQUIRE(lmsg.Name() == rmsg.Name());
+        REQUIRE(lmsg.MessageSize() == rmsg.MessageSize());
+        REQUIRE(lmsg.Transmitter() == rmsg.Transmitter());
+        REQUIRE(lmsg.MessageTransmitters_Size() == rmsg.MessageTransmitters_Size());
+        REQUIRE(lmsg.SignalGroups_Size() == rmsg.SignalGroups_Size());
+        REQUIRE(lmsg.AttributeValues_Size() == rmsg.AttributeValues_Size());
+        for (std::size_t j = 0; j < lmsg.AttributeValues_Size(); j++)
+        {
+            requireSameAttributes(lmsg.AttributeValues_Get(j), rmsg.AttributeValues_Get(j));
+        }
+        REQUIRE(lmsg.Signals_Size() == rmsg.Signals_Size());
+        for (std::size_t j = 0; j < lmsg.Signals_Size(); j++)
+        {
+            const auto& lsig = lmsg.Signals_Get(j);
+            const auto& rsig = rmsg.Signals_Get(j);
+            REQUIRE(lsig.Name() == rsig.Name());
+            REQUIRE(lsig.MultiplexerIndicator() == rsig.MultiplexerIndicator());
+            REQUIRE(lsig.MultiplexerSwitchValue() == rsig.MultiplexerSwitchValue());
+            REQUIRE(lsig.StartBit() == rsig.StartBit());
+            REQUIRE(lsig.BitSize() == rsig.BitSize());
+            REQUIRE(lsig.ByteOrder() == rsig.ByteOrder());
+            REQUIRE(lsig.ValueType() == rsig.ValueType());
+            REQUIRE(lsig.ExtendedValueType() == rsig.ExtendedValueType());
+            REQUIRE(lsig.Factor() == rsig.Factor());
+            REQUIRE(lsig.Offset() == rsig.Offset());
+            REQUIRE(lsig.Minimum() == rsig.Minimum());
+            REQUIRE(lsig.Maximum() == rsig.Maximum());
+            REQUIRE(lsig.Unit() == rsig.Unit());
+            REQUIRE(lsig.Receivers_Size() == rsig.Receivers_Size());
+            REQUIRE(lsig.ValueEncodingDescriptions_Size() == rsig.ValueEncodingDescriptions_Size());
+            for (std::size_t k = 0; k < lsig.ValueEncodingDescriptions_Size(); k++)
+            {
+                REQUIRE(lsig.ValueEncodingDescriptions_Get(k).Value() == rsig.ValueEncodingDescriptions_Get(k).Value());
+                REQUIRE(lsig.ValueEncodingDescriptions_Get(k).Description() == rsig.ValueEncodingDescriptions_Get(k).Description());
+            }
+            REQUIRE(lsig.AttributeValues_Size() == rsig.AttributeValues_Size());
+            REQUIRE(lsig.SignalMultiplexerValues_Size() == rsig.SignalMultiplexerValues_Size());
+        }
+    }
+}
+
+TEST_CASE("Network snapshots", "[unit]")
+{
+    auto snapshot_path = (std::filesystem::temp_directory_path() / "dbcppp_snapshot_test.snap").string();
+    for (const auto& dbc_file : std::filesystem::directory_iterator(std::filesystem::path(TEST_FILES_PATH) / "dbc"))
+    {
+        if (dbc_file.path().extension() != ".dbc")
+        {
+            continue;
+        }
+        std::string path_str = dbc_file.path().string();
+        INFO(path_str);
+        auto network = dbcppp::INetwork::LoadDBCFromFile(path_str.c_str());
+        if (!network)
+        {
+            continue;
+        }
+        REQUIRE(network->SaveSnapshot(snapshot_path.c_str()));
+        auto loaded = dbcppp::INetwork::LoadSnapshot(snapshot_path.c_str());
+        REQUIRE(loaded);
+        requireSameNetwork(*network, *loaded);
+
+        // decoding straight from the snapshot matches the network
+        std::string data;
+        dbcppp::WriteSnapshot(*network, data);
+        dbcppp::NetworkSnapshot snapshot;
+        REQUIRE(snapshot.Open(data));
+        REQUIRE(snapshot.Count(dbcppp::snapshot::Messages) == network->Messages_Size());
+        auto view = dbcppp::ISnapshotView::Open(data);
+        REQUIRE(view);
+        REQUIRE(view->Messages_Size() == network->Messages_Size());
+        uint8_t frame[64];
+        for (std::size_t i = 0; i < sizeof(frame); i++)
+        {
+            frame[i] = uint8_t(i * 37 + 11);
+        }
+        for (const auto& msg : network->Messages())
+        {
+            const auto* rec = snapshot.FindMessage(msg.Id());
+            REQUIRE(rec != nullptr);
+            REQUIRE(snapshot.String(rec->name) == network->FindMessage(msg.Id())->Name());
+            std::vector<double> expected(msg.Signals_Size());
+            std::vector<double> actual(msg.Signals_Size());
+            REQUIRE(msg.DecodeAll(frame, sizeof(frame), expected.data()) == msg.Signals_Size());
+            REQUIRE(snapshot.DecodeAll(*rec, frame, sizeof(frame), actual.data()) == msg.Signals_Size());
+            REQUIRE(expected == actual);
+
+            std::size_t i = view->FindMessage(msg.Id());
+            REQUIRE(i != dbcppp::ISnapshotView::npos);
+            REQUIRE(view->MessageId(i) == msg.Id());
+            REQUIRE(view->MessageName(i) == msg.Name());
+            REQUIRE(view->Signals_Size(i) == msg.Signals_Size());
+            for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+            {
+                REQUIRE(view->SignalName(i, j) == msg.Signals_Get(j).Name());
+            }
+            std::vector<double> viewed(msg.Signals_Size());
+            REQUIRE(view->DecodeAll(i, frame, sizeof(frame), viewed.data()) == msg.Signals_Size());
+            REQUIRE(expected == viewed);
+        }
+    }
+    SECTION("Invalid snapshots are rejected")
+    {
+        auto network = dbcppp::INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/dbc/Test.dbc").c_str());
+        REQUIRE(network);
+        std::string data;
+        dbcppp::WriteSnapshot(*network, data);
+        dbcppp::NetworkSnapshot snapshot;
+        REQUIRE(snapshot.Open(data));
+
+        std::string truncated = data.substr(0, data.size() - 1);
+        REQUIRE(!snapshot.Open(truncated));
+        REQUIRE(dbcppp::ISnapshotView::Open(truncated) == nullptr);
+
+        std::string wrong_version = data;
+        wrong_version[8] ^= 0x7F;
+        REQUIRE(!snapshot.Open(wrong_version));
+
+        // a string reference pointing past the pool
+        std::string corrupt = data;
+        auto* header = reinterpret_cast<dbcppp::snapshot::Header*>(&corrupt[0]);
+        header->version_string.size = uint32_t(header->tables[dbcppp::snapshot::Pool].count + 1);
+        REQUIRE(!snapshot.Open(corrupt));
+
+        // a DBC file is not a snapshot
+        REQUIRE(dbcppp::INetwork::LoadSnapshot((std::string(TEST_FILES_PATH) + "/dbc/Test.dbc").c_str()) == nullptr);
+    }
+    std::filesystem::remove(snapshot_path);
+}
+
+TEST_CASE("Compile cache", "[unit]")
+{
+    // XXH64 reference values
+    REQUIRE(dbcppp::ContentHash::Hash("") == 0xEF46DB3751D8E999ull);
+    REQUIRE(dbcppp::ContentHash::Hash("abc") == 0x44BC2CF5AD770999ull);
+
+    auto cache_dir = std::filesystem::temp_directory_path() / "dbcppp_compile_cache_test";
+    std::filesystem::remove_all(cache_dir);
+    std::filesystem::create_directories(cache_dir);
+    auto dbc_path = (cache_dir / "net.dbc").string();
+    auto write_dbc = [&](const std::string& message_name)
+    {
+        FILE* file = std::fopen(dbc_path.c_str(), "wb");
+        REQUIRE(file);
+        std::string dbc = "VERSION \"\"\nNS_ :\nBS_:\nBU_ ECU1\n\n"
+            "BO_ 100 " + message_name + ": 8 ECU1\n SG_ Sig0 : 0|8@1+ (1,0) [0|255] \"\" ECU1\n"
+            "BO_ 200 Other: 8 ECU1\n SG_ Sig1 : 0|8@1+ (1,0) [0|255] \"\" ECU1\n";
+        std::fwrite(dbc.data(), 1, dbc.size(), file);
+        std::fclose(file);
+    };
+    auto cache_entries = [&]()
+    {
+        std::vector<std::string> entries;
+        for (const auto& entry : std::filesystem::directory_iterator(cache_dir))
+        {
+            if (entry.path().extension() == ".snap")
+            {
+                entries.push_back(entry.path().string());
+            }
+        }
+        return entries;
+    };
+    dbcppp::INetwork::LoadOptions options;
+    options.cache_dir = cache_dir.string();
+
+    write_dbc("First");
+    auto network = dbcppp::INetwork::LoadDBCFromFile(dbc_path.c_str(), options);
+    REQUIRE(network);
+    REQUIRE(network->FindMessage(100)->Name() == "First");
+    auto entries = cache_entries();
+    REQUIRE(entries.size() == 1);
+
+    // a hit is served from the entry without parsing the DBC: replace the entry with another
+    // network's snapshot and that network comes back
+    auto other = dbcppp::INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/dbc/Test.dbc").c_str());
+    REQUIRE(other);
+    REQUIRE(other->SaveSnapshot(entries[0].c_str()));
+    auto cached = dbcppp::INetwork::LoadDBCFromFile(dbc_path.c_str(), options);
+    REQUIRE(cached);
+    requireSameNetwork(*other, *cached);
+    REQUIRE(network->SaveSnapshot(entries[0].c_str()));
+    cached = dbcppp::INetwork::LoadDBCFromFile(dbc_path.c_str(), options);
+    REQUIRE(cached);
+    requireSameNetwork(*network, *cached);
+
+    // different filters are kept apart by their key
+    options.filter_key = "only 100";
+    auto filtered = dbcppp::INetwork::LoadDBCFromFile(dbc_path.c_str(), options,
+        [](uint32_t id, const std::string&) { return id == 100; });
+    REQUIRE(filtered);
+    REQUIRE(filtered->Messages_Size() == 1);
+    REQUIRE(cache_entries().size() == 2);
+    filtered = dbcppp::INetwork::LoadDBCFromFile(dbc_path.c_str(), options,
+        [](uint32_t id, const std::string&) { return id == 100; });
+    REQUIRE(filtered->Messages_Size() == 1);
+    options.filter_key.clear();
+    // filters without a key neither hit the unfiltered entry nor add one
+    filtered = dbcppp::INetwork::LoadDBCFromFile(dbc_path.c_str(), options,
+        [](uint32_t id, const std::string&) { return id == 200; });
+    REQUIRE(filtered);
+    REQUIRE(filtered->Messages_Size() == 1);
+    REQUIRE(filtered->FindMessage(200));
+    REQUIRE(cache_entries().size() == 2);
+
+    // changed contents miss
+    write_dbc("Second");
+    network = dbcppp::INetwork::LoadDBCFromFile(dbc_path.c_str(), options);
+    REQUIRE(network);
+    REQUIRE(network->FindMessage(100)->Name() == "Second");
+    REQUIRE(cache_entries().size() == 3);
+
+    // an unusable entry is rebuilt
+    for (const auto& entry : cache_entries())
+    {
+        FILE* file = std::fopen(entry.c_str(), "wb");
+        std::fputs("garbage", file);
+        std::fclose(file);
+    }
+    network = dbcppp::INetwork::LoadDBCFromFile(dbc_path.c_str(), options);
+    REQUIRE(network);
+    REQUIRE(network->FindMessage(100)->Name() == "Second");
+    REQUIRE(cache_entries().size() == 3);
+    // entries are renamed into place, no temporary files are left behind
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir))
+    {
+        REQUIRE(entry.path().extension() != ".tmp");
+    }
+    std::filesystem::remove_all(cache_dir);
+}
+
+TEST_CASE("Arena backed networks", "[unit]")
+{
+    SECTION("Arena allocations")
+    {
+        dbcppp::Arena arena(1024);
+        REQUIRE(dbcppp::Arena::Current() == nullptr);
+        {
+            dbcppp::ArenaScope scope(arena);
+            REQUIRE(dbcppp::Arena::Current() == &arena);
+            dbcppp::Arena inner;
+            {
+                dbcppp::ArenaScope inner_scope(inner);
+                REQUIRE(dbcppp::Arena::Current() == &inner);
+            }
+            REQUIRE(dbcppp::Arena::Current() == &arena);
+        }
+        REQUIRE(dbcppp::Arena::Current() == nullptr);
+
+        for (std::size_t align : {1, 2, 8, 16, 64})
+        {
+            void* p = arena.Allocate(3, align);
+            REQUIRE(reinterpret_cast<uintptr_t>(p) % align == 0);
+        }
+        // large requests don't waste the current block
+        std::size_t blocks = arena.BlockCount();
+        char* small = static_cast<char*>(arena.Allocate(8, 8));
+        arena.Allocate(4096, 8);
+        REQUIRE(arena.BlockCount() == blocks + 1);
+        char* next = static_cast<char*>(arena.Allocate(8, 8));
+        REQUIRE(next == small + 8);
+    }
+    SECTION("Loading into an arena")
+    {
+        auto path = std::string(TEST_FILES_PATH) + "/dbc/Model3CAN.dbc";
+        auto network = dbcppp::INetwork::LoadDBCFromFile(path.c_str());
+        REQUIRE(network);
+        dbcppp::INetwork::LoadOptions options;
+        options.arena_block_size = 16 * 1024;
+        auto arena_network = dbcppp::INetwork::LoadDBCFromFile(path.c_str(), options);
+        REQUIRE(arena_network);
+        REQUIRE(dbcppp::Arena::Current() == nullptr);
+        requireSameNetwork(*network, *arena_network);
+
+        const auto* arena = static_cast<const dbcppp::NetworkImpl&>(*arena_network).GetArena();
+        REQUIRE(arena != nullptr);
+        REQUIRE(arena->BlockCount() < arena_network->Messages_Size());
+        REQUIRE(static_cast<const dbcppp::NetworkImpl&>(*network).GetArena() == nullptr);
+
+        uint8_t frame[64];
+        for (std::size_t i = 0; i < sizeof(frame); i++)
+        {
+            frame[i] = uint8_t(i * 13 + 5);
+        }
+        // copies made outside of the load are independent of the arena
+        std::vector<dbcppp::MessageImpl> copies;
+        for (const auto& msg : arena_network->Messages())
+        {
+            copies.push_back(static_cast<const dbcppp::MessageImpl&>(msg));
+        }
+        std::vector<std::vector<double>> expected;
+        for (const auto& msg : network->Messages())
+        {
+            expected.emplace_back(msg.Signals_Size());
+            msg.DecodeAll(frame, sizeof(frame), expected.back().data());
+        }
+        arena_network.reset();
+        for (std::size_t i = 0; i < copies.size(); i++)
+        {
+            std::vector<double> actual(copies[i].Signals_Size());
+            REQUIRE(copies[i].DecodeAll(frame, sizeof(frame), actual.data()) == actual.size());
+            REQUIRE(actual == expected[i]);
+            REQUIRE(copies[i].Name() == network->Messages_Get(i).Name());
+        }
+    }
+}
+
+TEST_CASE("Static network storage", "[unit]")
+{
+    SECTION("Buffer backed arena")
+    {
+        alignas(std::max_align_t) char buffer[256];
+        dbcppp::Arena arena(buffer, sizeof(buffer));
+        char* first = static_cast<char*>(arena.Allocate(100, 8));
+        REQUIRE(first == buffer);
+        REQUIRE(static_cast<char*>(arena.Allocate(100, 8)) == buffer + 104);
+        REQUIRE(!arena.Exhausted());
+        REQUIRE(arena.BlockCount() == 0);
+        // requests which don't fit are served from the heap and mark the arena
+        char* heap = static_cast<char*>(arena.Allocate(100, 8));
+        REQUIRE((heap < buffer || heap >= buffer + sizeof(buffer)));
+        REQUIRE(arena.Exhausted());
+        REQUIRE(arena.Used() >= 304);
+    }
+    SECTION("Loading into static storage")
+    {
+        auto path = std::string(TEST_FILES_PATH) + "/dbc/Model3CAN.dbc";
+        auto network = dbcppp::INetwork::LoadDBCFromFile(path.c_str());
+        REQUIRE(network);
+
+        static dbcppp::NetworkStorage<4 * 1024> small;
+        auto overflow = dbcppp::INetwork::LoadDBCIntoStorage(path.c_str(), small, {});
+        REQUIRE(overflow.isError());
+        REQUIRE(overflow.error().code == dbcppp::ParseErrorCode::CapacityExceeded);
+        REQUIRE(dbcppp::Arena::Current() == nullptr);
+
+        auto missing = dbcppp::INetwork::LoadDBCIntoStorage("does_not_exist.dbc", small, {});
+        REQUIRE(missing.isError());
+        REQUIRE(missing.error().code == dbcppp::ParseErrorCode::LoadFailed);
+
+        static dbcppp::NetworkStorage<2 * 1024 * 1024> storage;
+        auto result = dbcppp::INetwork::LoadDBCIntoStorage(path.c_str(), storage, {});
+        REQUIRE(result.isOk());
+        auto loaded = result.moveValue();
+        requireSameNetwork(*network, *loaded);
+        const auto* arena = static_cast<const dbcppp::NetworkImpl&>(*loaded).GetArena();
+        REQUIRE(arena != nullptr);
+        REQUIRE(arena->BlockCount() == 0);
+        const auto* first = reinterpret_cast<const unsigned char*>(&loaded->Messages_Get(0));
+        REQUIRE((first >= storage.bytes && first < storage.bytes + sizeof(storage.bytes)));
+    }
+}
+
+TEST_CASE("Interned strings", "[unit]")
+{
+    dbcppp::StringPool pool;
+    const std::string& unit = pool.Intern("km/h");
+    REQUIRE(&pool.Intern(std::string("km/h")) == &unit);
+    REQUIRE(&pool.Intern("rpm") != &unit);
+    REQUIRE(pool.Size() == 2);
+
+    auto path = std::string(TEST_FILES_PATH) + "/dbc/Model3CAN.dbc";
+    auto network = dbcppp::INetwork::LoadDBCFromFile(path.c_str());
+    REQUIRE(network);
+    const auto* strings = static_cast<const dbcppp::NetworkImpl&>(*network).GetStrings();
+    REQUIRE(strings != nullptr);
+
+    // equal receivers of different signals are the same string
+    const std::string* receiver = nullptr;
+    std::size_t receivers = 0;
+    for (const auto& msg : network->Messages())
+    {
+        for (const auto& sig : msg.Signals())
+        {
+            for (const auto& r : sig.Receivers())
+            {
+                receiver = receiver ? receiver : &r;
+                if (r == *receiver)
+                {
+                    REQUIRE(&r == receiver);
+                    receivers++;
+                }
+            }
+        }
+    }
+    REQUIRE(receivers > 1);
+    REQUIRE(strings->Size() < receivers);
+
+    // a copy doesn't depend on the network it was copied from
+    dbcppp::MessageImpl copy = static_cast<const dbcppp::MessageImpl&>(network->Messages_Get(0));
+    std::string transmitter = network->Messages_Get(0).Transmitter();
+    network.reset();
+    REQUIRE(copy.Transmitter() == transmitter);
+
+    // outside of a scope handles own their string, inside they share the pool's
+    dbcppp::PooledString owned("km/h");
+    dbcppp::PooledString owned_copy(owned);
+    REQUIRE(&owned.Get() != &owned_copy.Get());
+    REQUIRE(owned_copy.Get() == "km/h");
+    {
+        dbcppp::StringPoolScope scope(pool);
+        dbcppp::PooledString pooled(owned);
+        REQUIRE(&pooled.Get() == &unit);
+        owned_copy = pooled;
+        REQUIRE(&owned_copy.Get() == &unit);
+    }
+    dbcppp::PooledString moved(std::move(owned));
+    REQUIRE(moved.Get() == "km/h");
+    REQUIRE(owned.Get().empty());
+    owned = moved;
+    REQUIRE(owned.Get() == "km/h");
+    REQUIRE(&owned.Get() != &moved.Get());
+}
+
+TEST_CASE("Convert synthetic DBC with many attributes", "[unit]")
+{
+    // 2000 messages x 4 signals, 25 attribute values per message (50k in total)
+    // plus per signal value descriptions and per message BO_TX_BU_/SIG_GROUP_ statements
+    constexpr std::size_t n_messages = 2000;
+    constexpr std::size_t n_signals = 4;
+    std::string dbc = "VERSION \"\"\nNS_ :\nBS_:\nBU_ ECU1 ECU2\n\n";
+    for (std::size_t i = 0; i < n_messages; i++)
+    {
+        std::string id = std::to_string(0x100 + i);
+        dbc += "BO_ " + id + " Msg" + std::to_string(i) + ": 8 ECU1\n";
+        for (std::size_t j = 0; j < n_signals; j++)
+        {
+            dbc += " SG_ Sig" + std::to_string(j) + " : " + std::to_string(j * 16) + "|16@1+ (1,0) [0|65535] \"\" ECU2\n";
+        }
+        dbc += "\n";
+    }
+    dbc += "BA_DEF_ BO_ \"MsgAttr\" INT 0 1000000;\n";
+    dbc += "BA_DEF_ SG_ \"SigAttr\" INT 0 1000000;\n";
+    for (std::size_t i = 0; i < n_messages; i++)
+    {
+        std::string id = std::to_string(0x100 + i);
+        dbc += "BO_TX_BU_ " + id + " : ECU1,ECU2;\n";
+        dbc += "SIG_GROUP_ " + id + " Group 1 : Sig0 Sig1;\n";
+        for (std::size_t k = 0; k < 5; k++)
+        {
+            dbc += "BA_ \"MsgAttr\" BO_ " + id + " " + std::to_string(i + k) + ";\n";
+        }
+        for (std::size_t j = 0; j < n_signals; j++)
+        {
+            std::string sig = " Sig" + std::to_string(j);
+            for (std::size_t k = 0; k < 5; k++)
+            {
+                dbc += "BA_ \"SigAttr\" SG_ " + id + sig + " " + std::to_string(j + k) + ";\n";
+            }
+            dbc += "VAL_ " + id + sig + " 0 \"Off\" 1 \"On\" ;\n";
+        }
+        dbc += "SIG_VALTYPE_ " + id + " Sig1 : 1;\n";
+    }
+
+    auto network = dbcppp::INetwork::LoadDBCFromString(dbc);
+    REQUIRE(network);
+    REQUIRE(network->Messages_Size() == n_messages);
+    for (std::size_t i = 0; i < n_messages; i += 397)
+    {
+        const auto& msg = network->Messages_Get(i);
+        REQUIRE(msg.Id() == 0x100 + i);
+        REQUIRE(msg.AttributeValues_Size() == 5);
+        REQUIRE(std::get<int64_t>(msg.AttributeValues_Get(4).Value()) == int64_t(i + 4));
+        REQUIRE(msg.MessageTransmitters_Size() == 2);
+        REQUIRE(msg.SignalGroups_Size() == 1);
+        REQUIRE(msg.Signals_Size() == n_signals);
+        for (std::size_t j = 0; j < n_signals; j++)
+        {
+            const auto& sig = msg.Signals_Get(j);
+            REQUIRE(sig.AttributeValues_Size() == 5);
+            REQUIRE(std::get<int64_t>(sig.AttributeValues_Get(0).Value()) == int64_t(j));
+            REQUIRE(sig.ValueEncodingDescriptions_Size() == 2);
+            REQUIRE(sig.ExtendedValueType() == (j == 1
+                ? dbcppp::ISignal::EExtendedValueType::Float
+                : dbcppp::ISignal::EExtendedValueType::Integer));
+        }
+    }
+}
+
 TEST_CASE("Parse Large DBC File", "[unit]")
 {
     std::string test17_path = std::string(TEST_FILES_PATH) + "/dbc/test17.dbc";
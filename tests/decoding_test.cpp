@@ -8,11 +8,57 @@
 #include <random>
 #include <string>
 #include <iomanip>
+#include <cstring>
+#include <map>
+#include <new>
+#include <cstdlib>
 
 #include "../include/dbcppp-tiny/network.h"
+#include "../include/dbcppp-tiny/static_signal.h"
+#include "../src/signal_batch.h"
+#include "../src/decode_jit.h"
+#include "../src/network_impl.h"
+
+#include "config.h"
 
 #include <catch2/catch_test_macros.hpp>
 
+namespace
+{
+    // Allocation hook: counts the global operator new calls made on this thread while enabled
+    thread_local bool count_allocations = false;
+    thread_local std::size_t allocation_count = 0;
+}
+void* operator new(std::size_t size)
+{
+    if (count_allocations)
+    {
+        allocation_count++;
+    }
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+// std::stable_sort & co. allocate through the nothrow form, which has to pair with the delete below
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    if (count_allocations)
+    {
+        allocation_count++;
+    }
+    return std::malloc(size ? size : 1);
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 auto generate_random_signal(
       std::size_t max_msg_byte_size
     , std::default_random_engine& rng)
@@ -182,4 +228,565 @@ TEST_CASE("Decoding")
         REQUIRE(*reinterpret_cast<uint64_t*>(&dec_easy) == *reinterpret_cast<uint64_t*>(&dec_sig));
     }
     //BOOST_TEST_MESSAGE("Done!");
-}
\ No newline at end of file
+}
+static uint64_t bits_of(double v)
+{
+    uint64_t result;
+    std::memcpy(&result, &v, sizeof(result));
+    return result;
+}
+TEST_CASE("Decoding: DecodeAll")
+{
+    using namespace dbcppp;
+
+    std::size_t n_tests = 1000;
+    std::size_t max_msg_byte_size = 64;
+
+    uint32_t seed = static_cast<uint32_t>(time(0));
+    std::default_random_engine rng(seed);
+    std::uniform_int_distribution<std::mt19937::result_type> dist(0, -1);
+
+    SECTION("Random signals")
+    {
+        for (std::size_t i = 0; i < n_tests; i++)
+        {
+            std::size_t n_sigs = dist(rng) % 48 + 1;
+            std::vector<std::unique_ptr<ISignal>> sigs;
+            for (std::size_t j = 0; j < n_sigs; j++)
+            {
+                sigs.push_back(generate_random_signal(max_msg_byte_size, rng));
+            }
+            auto msg = IMessage::Create(1, "Msg", max_msg_byte_size, "", {}, std::move(sigs), {}, {});
+            // the per-signal decoder may read up to 8 bytes past a signal, keep that inside the buffer
+            auto data = generate_random_data(max_msg_byte_size, rng);
+            data.resize(max_msg_byte_size + 16, 0);
+
+            std::vector<double> values(msg->Signals_Size());
+            REQUIRE(msg->DecodeAll(data.data(), max_msg_byte_size, values.data()) == msg->Signals_Size());
+            for (std::size_t j = 0; j < msg->Signals_Size(); j++)
+            {
+                const ISignal& sig = msg->Signals_Get(j);
+                INFO("Test " << i << " signal " << j << " StartBit:" << sig.StartBit() << " BitSize:" << sig.BitSize());
+                REQUIRE(bits_of(values[j]) == bits_of(sig.RawToPhys(sig.Decode(data.data()))));
+            }
+        }
+    }
+    SECTION("Short frames are zero padded")
+    {
+        std::vector<std::unique_ptr<ISignal>> sigs;
+        sigs.push_back(ISignal::Create(16, "Low", ISignal::EMultiplexer::NoMux, 0, 0, 8,
+            ISignal::EByteOrder::LittleEndian, ISignal::EValueType::Unsigned, 2.0, 1.0, 0.0, 0.0, "", {}, {}, {}, ISignal::EExtendedValueType::Integer, {}));
+        sigs.push_back(ISignal::Create(16, "High", ISignal::EMultiplexer::NoMux, 0, 100, 16,
+            ISignal::EByteOrder::LittleEndian, ISignal::EValueType::Signed, 1.0, 0.0, 0.0, 0.0, "", {}, {}, {}, ISignal::EExtendedValueType::Integer, {}));
+        auto msg = IMessage::Create(1, "Msg", 16, "", {}, std::move(sigs), {}, {});
+        uint8_t frame[2] = {0x10, 0xFF};
+        double values[2];
+        REQUIRE(msg->DecodeAll(frame, sizeof(frame), values) == 2);
+        REQUIRE(values[0] == 0x10 * 2.0 + 1.0);
+        REQUIRE(values[1] == 0.0);
+    }
+    SECTION("Model3CAN.dbc")
+    {
+        auto net = INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/dbc/Model3CAN.dbc").c_str());
+        REQUIRE(net);
+        for (const IMessage& msg : net->Messages())
+        {
+            std::vector<double> values(msg.Signals_Size());
+            for (std::size_t i = 0; i < 16; i++)
+            {
+                auto data = generate_random_data(64 + 16, rng);
+                REQUIRE(msg.DecodeAll(data.data(), 64, values.data()) == msg.Signals_Size());
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    const ISignal& sig = msg.Signals_Get(j);
+                    INFO(msg.Name() << "." << sig.Name());
+                    REQUIRE(bits_of(values[j]) == bits_of(sig.RawToPhys(sig.Decode(data.data()))));
+                }
+            }
+        }
+    }
+}
+TEST_CASE("Decoding: DecodeActive")
+{
+    using namespace dbcppp;
+
+    uint32_t seed = static_cast<uint32_t>(time(0));
+    std::default_random_engine rng(seed);
+
+    // reference: decode the switch per signal and compare the switch value, like the README example used to
+    auto check = [](const IMessage& msg, const std::vector<uint8_t>& data, std::size_t len)
+    {
+        std::vector<std::size_t> indices(msg.Signals_Size());
+        std::vector<double> values(msg.Signals_Size());
+        std::size_t n = msg.DecodeActive(data.data(), len, indices.data(), values.data());
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < msg.Signals_Size(); i++)
+        {
+            const ISignal& sig = msg.Signals_Get(i);
+            const ISignal* mux_sig = msg.MuxSignal();
+            if (sig.MultiplexerIndicator() != ISignal::EMultiplexer::MuxValue ||
+                (mux_sig && mux_sig->Decode(data.data()) == sig.MultiplexerSwitchValue()))
+            {
+                INFO(msg.Name() << "." << sig.Name());
+                REQUIRE(k < n);
+                REQUIRE(indices[k] == i);
+                REQUIRE(bits_of(values[k]) == bits_of(sig.RawToPhys(sig.Decode(data.data()))));
+                k++;
+            }
+        }
+        REQUIRE(k == n);
+    };
+    SECTION("Model3CAN.dbc")
+    {
+        auto net = INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/dbc/Model3CAN.dbc").c_str());
+        REQUIRE(net);
+        for (const IMessage& msg : net->Messages())
+        {
+            for (std::size_t i = 0; i < 64; i++)
+            {
+                auto data = generate_random_data(64 + 16, rng);
+                if (msg.MuxSignal() && i % 2 == 0)
+                {
+                    // bias towards switch values that select a page
+                    const ISignal& mux = *msg.MuxSignal();
+                    if (mux.StartBit() == 0 && mux.BitSize() <= 8 && mux.ByteOrder() == ISignal::EByteOrder::LittleEndian)
+                    {
+                        data[0] = uint8_t(data[0] & ((1u << mux.BitSize()) - 1) & 0x7);
+                    }
+                }
+                check(msg, data, 64);
+            }
+        }
+    }
+    SECTION("Sparse switch values")
+    {
+        std::vector<std::unique_ptr<ISignal>> sigs;
+        sigs.push_back(ISignal::Create(8, "Mux", ISignal::EMultiplexer::MuxSwitch, 0, 0, 32,
+            ISignal::EByteOrder::LittleEndian, ISignal::EValueType::Unsigned, 1.0, 0.0, 0.0, 0.0, "", {}, {}, {}, ISignal::EExtendedValueType::Integer, {}));
+        sigs.push_back(ISignal::Create(8, "Always", ISignal::EMultiplexer::NoMux, 0, 56, 8,
+            ISignal::EByteOrder::LittleEndian, ISignal::EValueType::Unsigned, 1.0, 0.0, 0.0, 0.0, "", {}, {}, {}, ISignal::EExtendedValueType::Integer, {}));
+        for (uint64_t value : {7ull, 100000ull, 0x12345678ull})
+        {
+            sigs.push_back(ISignal::Create(8, "Page" + std::to_string(value), ISignal::EMultiplexer::MuxValue, value, 32, 16,
+                ISignal::EByteOrder::LittleEndian, ISignal::EValueType::Signed, 0.5, 1.0, 0.0, 0.0, "", {}, {}, {}, ISignal::EExtendedValueType::Integer, {}));
+        }
+        auto msg = IMessage::Create(1, "Msg", 8, "", {}, std::move(sigs), {}, {});
+        for (uint32_t value : {7u, 8u, 100000u, 0x12345678u, 0u})
+        {
+            std::vector<uint8_t> data(16, 0);
+            for (std::size_t i = 0; i < 4; i++)
+            {
+                data[i] = uint8_t(value >> (8 * i));
+            }
+            data[4] = 0xFE;
+            data[5] = 0xFF;
+            data[7] = 42;
+            check(*msg, data, 8);
+        }
+    }
+}
+TEST_CASE("Decoding: Extended multiplexing")
+{
+    using namespace dbcppp;
+
+    auto load = [](const char* name)
+    {
+        auto net = INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/dbc/" + name).c_str());
+        REQUIRE(net);
+        REQUIRE(net->Messages_Size() == 1);
+        return net;
+    };
+    auto active = [](const IMessage& msg, std::vector<uint8_t> data)
+    {
+        data.resize(16, 0);
+        std::vector<std::size_t> indices(msg.Signals_Size());
+        std::vector<double> values(msg.Signals_Size());
+        std::size_t n = msg.DecodeActive(data.data(), 8, indices.data(), values.data());
+        std::map<std::string, double> result;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            result[msg.Signals_Get(indices[i]).Name()] = values[i];
+        }
+        return result;
+    };
+    using Active = std::map<std::string, double>;
+    SECTION("Cascaded")
+    {
+        auto net = load("issue_184_extended_mux_cascaded.dbc");
+        const IMessage& msg = net->Messages_Get(0);
+        REQUIRE(active(msg, {2, 2, 0, 0, 1, 0xFF}) == Active{{"MUX_A", 2}, {"muxed_A_2_MUX_B", 2}, {"muxed_A_2_MUX_B_MUX_C", 1}, {"muxed_C_1", -1}});
+        REQUIRE(active(msg, {2, 0, 5, 0, 1, 0}) == Active{{"MUX_A", 2}, {"muxed_A_2_MUX_B", 0}, {"muxed_B_0", 5}});
+        REQUIRE(active(msg, {2, 1, 0, 7, 0, 0}) == Active{{"MUX_A", 2}, {"muxed_A_2_MUX_B", 1}, {"muxed_B_1", 7}});
+        REQUIRE(active(msg, {1, 9, 0, 0, 2, 0}) == Active{{"MUX_A", 1}, {"muxed_A_1", 9}});
+        REQUIRE(active(msg, {0, 2, 0, 0, 2, 0}) == Active{{"MUX_A", 0}});
+    }
+    SECTION("Independent multiplexors")
+    {
+        auto net = load("issue_184_extended_mux_independent_multiplexors.dbc");
+        const IMessage& msg = net->Messages_Get(0);
+        REQUIRE(active(msg, {0, 3, 2, 4}) == Active{{"MUX_A", 0}, {"muxed_A_0", 3}, {"MUX_B", 2}, {"muxed_B_2", 4}});
+        REQUIRE(active(msg, {1, 3, 1, 4}) == Active{{"MUX_A", 1}, {"muxed_A_1", 3}, {"MUX_B", 1}, {"muxed_B_1", 4}});
+        REQUIRE(active(msg, {5, 3, 0, 4}) == Active{{"MUX_A", 5}, {"MUX_B", 0}});
+    }
+    SECTION("Multiple value ranges")
+    {
+        auto net = load("issue_184_extended_mux_multiple_values.dbc");
+        const IMessage& msg = net->Messages_Get(0);
+        for (uint8_t value : {0, 3, 4, 5})
+        {
+            REQUIRE(active(msg, {value, 8}) == Active{{"MUX", value}, {"muxed_0_3_4_5", 8}});
+        }
+        REQUIRE(active(msg, {1, 8}) == Active{{"MUX", 1}, {"muxed_1", 8}});
+        REQUIRE(active(msg, {2, 8}) == Active{{"MUX", 2}, {"muxed_2", 8}});
+        REQUIRE(active(msg, {6, 8}) == Active{{"MUX", 6}});
+    }
+}
+TEST_CASE("Decoding: DecodeBatch")
+{
+    using namespace dbcppp;
+
+    uint32_t seed = static_cast<uint32_t>(time(0));
+    std::default_random_engine rng(seed);
+    std::uniform_int_distribution<std::mt19937::result_type> dist(0, -1);
+
+    const std::size_t frame_size = 64;
+    const std::size_t stride = frame_size + 16;
+    auto check = [&](const ISignal& sig, BatchIsa isa)
+    {
+        std::size_t n = dist(rng) % 67;
+        auto frames = generate_random_data(n * stride + 16, rng);
+        std::vector<uint64_t> raw(n);
+        std::vector<double> phys(n);
+        DecodeStep step = DecodePlan::MakeStep(static_cast<const SignalImpl&>(sig));
+        DecodeBatch(step, frames.data(), stride, n, raw.data(), isa);
+        DecodeBatch(step, frames.data(), stride, n, phys.data(), isa);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const uint8_t* frame = frames.data() + i * stride;
+            INFO("isa " << int(isa) << " signal " << sig.Name() << " StartBit:" << sig.StartBit() << " BitSize:" << sig.BitSize() << " frame " << i);
+            REQUIRE(raw[i] == sig.Decode(frame));
+            REQUIRE(bits_of(phys[i]) == bits_of(sig.RawToPhys(sig.Decode(frame))));
+        }
+    };
+    for (BatchIsa isa : {BatchIsa::Scalar, BatchIsa::SSE41, BatchIsa::AVX2})
+    {
+        if (!BatchIsaSupported(isa))
+        {
+            continue;
+        }
+        for (std::size_t i = 0; i < 2000; i++)
+        {
+            check(*generate_random_signal(frame_size, rng), isa);
+        }
+        auto net = INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/dbc/Model3CAN.dbc").c_str());
+        REQUIRE(net);
+        for (const IMessage& msg : net->Messages())
+        {
+            for (const ISignal& sig : msg.Signals())
+            {
+                check(sig, isa);
+            }
+        }
+    }
+    SECTION("ISignal API")
+    {
+        auto sig = ISignal::Create(8, "Sig", ISignal::EMultiplexer::NoMux, 0, 7, 12,
+            ISignal::EByteOrder::BigEndian, ISignal::EValueType::Signed, 0.25, -3.0, 0.0, 0.0, "", {}, {}, {}, ISignal::EExtendedValueType::Integer, {});
+        auto frames = generate_random_data(9 * 8 + 8, rng);
+        std::vector<ISignal::raw_t> raw(9);
+        std::vector<double> phys(9);
+        sig->DecodeBatch(frames.data(), 8, 9, raw.data());
+        sig->DecodeBatch(frames.data(), 8, 9, phys.data());
+        for (std::size_t i = 0; i < 9; i++)
+        {
+            REQUIRE(raw[i] == sig->Decode(&frames[i * 8]));
+            REQUIRE(bits_of(phys[i]) == bits_of(sig->RawToPhys(raw[i])));
+        }
+    }
+}
+TEST_CASE("Decoding: PEXT kernels")
+{
+    using namespace dbcppp;
+
+    if (!CpuSupportsBmi2())
+    {
+        WARN("CPU doesn't support BMI2, skipping");
+        return;
+    }
+    uint32_t seed = static_cast<uint32_t>(time(0));
+    std::default_random_engine rng(seed);
+
+    for (std::size_t i = 0; i < 10000; i++)
+    {
+        auto sig = generate_random_signal(64, rng);
+        auto data = generate_random_data(64 + 8, rng);
+        auto& sigi = static_cast<SignalImpl&>(*sig);
+        REQUIRE(sigi.SelectDecodeKernel(DecodeKernel::Template));
+        REQUIRE(sigi.SelectedDecodeKernel() == DecodeKernel::Template);
+        auto expected = sig->Decode(data.data());
+        bool pext = sigi.SelectDecodeKernel(DecodeKernel::Pext);
+        // spanning signals and, with compact descriptors, 32 bit signals keep their template kernel
+        REQUIRE(pext == (sigi._alignment == Alignment::size_inbetween_first_64_bit ||
+            sigi._alignment == Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit));
+        REQUIRE(sigi.SelectedDecodeKernel() == (pext ? DecodeKernel::Pext : DecodeKernel::Template));
+        INFO("StartBit:" << sig->StartBit() << " BitSize:" << sig->BitSize());
+        REQUIRE(sig->Decode(data.data()) == expected);
+    }
+}
+TEST_CASE("Decoding: Sign extension by shift")
+{
+    using namespace dbcppp;
+
+    auto make = [](uint64_t start_bit, uint64_t bit_size, ISignal::EValueType value_type)
+    {
+        return ISignal::Create(16, "Sig", ISignal::EMultiplexer::NoMux, 0, start_bit, bit_size,
+            ISignal::EByteOrder::LittleEndian, value_type, 1.0, 0.0, 0.0, 0.0, "", {}, {}, {}, ISignal::EExtendedValueType::Integer, {});
+    };
+    // all bits set, the sign bit of every signed signal
+    std::array<uint8_t, 16> ones;
+    ones.fill(0xFF);
+    for (uint64_t bit_size : {1, 7, 32, 63, 64})
+    {
+        for (uint64_t start_bit : {uint64_t(0), uint64_t(3), uint64_t(64 - bit_size % 64)})
+        {
+            INFO("StartBit:" << start_bit << " BitSize:" << bit_size);
+            auto sig = make(start_bit, bit_size, ISignal::EValueType::Signed);
+            auto usig = make(start_bit, bit_size, ISignal::EValueType::Unsigned);
+            DecodeStep step = DecodePlan::MakeStep(static_cast<const SignalImpl&>(*sig));
+            DecodeStep ustep = DecodePlan::MakeStep(static_cast<const SignalImpl&>(*usig));
+            REQUIRE(step.sign_shift == 64 - bit_size);
+            REQUIRE(ustep.sign_shift == 0);
+            REQUIRE(int64_t(sig->Decode(ones.data())) == -1);
+            REQUIRE(usig->Decode(ones.data()) == (bit_size == 64 ? ~0ull : (1ull << bit_size) - 1));
+            uint64_t first_le = DecodePlan::Load64(ones.data());
+            REQUIRE(int64_t(DecodePlan::Extract(step, ones.data(), first_le, first_le)) == -1);
+            REQUIRE(DecodePlan::Extract(ustep, ones.data(), first_le, first_le) == usig->Decode(ones.data()));
+        }
+    }
+}
+TEST_CASE("Decoding: Compact descriptors")
+{
+    using namespace dbcppp;
+
+    auto make = [](uint64_t start_bit, uint64_t bit_size, ISignal::EByteOrder byte_order)
+    {
+        return ISignal::Create(8, "Sig", ISignal::EMultiplexer::NoMux, 0, start_bit, bit_size,
+            byte_order, ISignal::EValueType::Signed, 0.1, -40.0, 0.0, 0.0, "", {}, {}, {}, ISignal::EExtendedValueType::Integer, {});
+    };
+    // zero padded like frames handed to DecodePlan::Extract, whose span steps read a 9th byte
+    const uint8_t data[16] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+    // Intel byte 6 and Motorola bytes 6..7, the 32 bit load has to start at byte 4
+    auto le = make(48, 8, ISignal::EByteOrder::LittleEndian);
+    auto be = make(55, 16, ISignal::EByteOrder::BigEndian);
+    REQUIRE(int64_t(le->Decode(data)) == int8_t(0xDE));
+    REQUIRE(int64_t(be->Decode(data)) == int16_t(0xDEF0));
+    const auto& lei = static_cast<const SignalImpl&>(*le);
+    const auto& bei = static_cast<const SignalImpl&>(*be);
+#ifdef DBCPPP_COMPACT_DESCRIPTORS
+    REQUIRE(lei._alignment == Alignment::signal_fits_into_32_bit);
+    REQUIRE(bei._alignment == Alignment::signal_fits_into_32_bit);
+    REQUIRE(lei._byte_pos == 4);
+    REQUIRE(bei._byte_pos == 4);
+    // scaling is done in single precision
+    REQUIRE(le->Factor() == double(0.1f));
+    REQUIRE(le->RawToPhys(le->Decode(data)) == double(float(int8_t(0xDE)) * 0.1f - 40.0f));
+#else
+    REQUIRE(lei._alignment == Alignment::size_inbetween_first_64_bit);
+    REQUIRE(bei._alignment == Alignment::size_inbetween_first_64_bit);
+    REQUIRE(le->Factor() == 0.1);
+    REQUIRE(le->RawToPhys(le->Decode(data)) == int8_t(0xDE) * 0.1 - 40.0);
+#endif
+    // decode plans agree with the signals whichever kernel they use
+    for (const ISignal* sig : {le.get(), be.get()})
+    {
+        DecodeStep step = DecodePlan::MakeStep(static_cast<const SignalImpl&>(*sig));
+        uint64_t first_le = DecodePlan::Load64(data);
+        uint64_t first_be = first_le;
+        native_to_little_inplace(first_le);
+        native_to_big_inplace(first_be);
+        uint64_t raw = DecodePlan::Extract(step, data, first_le, first_be);
+        REQUIRE(raw == sig->Decode(data));
+        REQUIRE(DecodePlan::RawToPhys(step, raw) == sig->RawToPhys(raw));
+    }
+}
+template <class S>
+void check_static_signal(std::default_random_engine& rng)
+{
+    using namespace dbcppp;
+
+    auto sig = ISignal::Create(64, "Sig", ISignal::EMultiplexer::NoMux, 0, S::start_bit, S::bit_size,
+        S::byte_order, S::value_type, S::factor, S::offset, 0.0, 0.0, "", {}, {}, {}, S::extended_value_type, {});
+    INFO("StartBit:" << S::start_bit << " BitSize:" << S::bit_size);
+    REQUIRE(sig->Error(ISignal::EErrorCode::NoError));
+    for (std::size_t i = 0; i < 100; i++)
+    {
+        auto data = generate_random_data(64 + 16, rng);
+        REQUIRE(S::Decode(data.data()) == sig->Decode(data.data()));
+#ifndef DBCPPP_COMPACT_DESCRIPTORS
+        REQUIRE(bits_of(S::Phys(data.data())) == bits_of(sig->RawToPhys(sig->Decode(data.data()))));
+#endif
+    }
+}
+TEST_CASE("Decoding: StaticSignal")
+{
+    using namespace dbcppp;
+    using LE = std::integral_constant<ISignal::EByteOrder, ISignal::EByteOrder::LittleEndian>;
+    using BE = std::integral_constant<ISignal::EByteOrder, ISignal::EByteOrder::BigEndian>;
+    constexpr auto sig = ISignal::EValueType::Signed;
+    constexpr auto usig = ISignal::EValueType::Unsigned;
+    constexpr auto i = ISignal::EExtendedValueType::Integer;
+
+    using VehicleSpeed = StaticSignal<24, 16, LE::value, usig, i, std::ratio<1, 100>>;
+    using BrakeState = StaticSignal<47, 2, BE::value, usig>;
+
+    std::default_random_engine rng(static_cast<uint32_t>(time(0)));
+    SECTION("Matches the runtime decoders")
+    {
+        check_static_signal<VehicleSpeed>(rng);
+        check_static_signal<BrakeState>(rng);
+        check_static_signal<StaticSignal<0, 64, LE::value, sig>>(rng);
+        check_static_signal<StaticSignal<7, 64, BE::value, usig>>(rng);
+        check_static_signal<StaticSignal<200, 20, LE::value, usig, i, std::ratio<1, 4>, std::ratio<10>>>(rng);
+        check_static_signal<StaticSignal<300, 12, BE::value, sig, i, std::ratio<1, 10>, std::ratio<-40>>>(rng);
+        check_static_signal<StaticSignal<4, 64, LE::value, usig>>(rng);
+        check_static_signal<StaticSignal<68, 61, LE::value, sig, i, std::ratio<1, 2>, std::ratio<-3>>>(rng);
+        check_static_signal<StaticSignal<131, 64, BE::value, usig>>(rng);
+        check_static_signal<StaticSignal<133, 60, BE::value, sig>>(rng);
+        check_static_signal<StaticSignal<384, 32, LE::value, sig, ISignal::EExtendedValueType::Float>>(rng);
+        check_static_signal<StaticSignal<448, 64, LE::value, sig, ISignal::EExtendedValueType::Double, std::ratio<2>, std::ratio<1>>>(rng);
+        check_static_signal<StaticSignal<4, 64, LE::value, sig, ISignal::EExtendedValueType::Double>>(rng);
+    }
+    SECTION("Layout and decode at compile time")
+    {
+        static_assert(VehicleSpeed::layout.alignment == Alignment::size_inbetween_first_64_bit);
+        static_assert(StaticSignal<200, 20, LE::value, usig>::layout.alignment == Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit);
+        static_assert(StaticSignal<4, 64, LE::value, usig>::layout.alignment == Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit);
+        static_assert(StaticSignal<4, 64, LE::value, usig>::extent == 9);
+
+        constexpr uint8_t frame[8] = {0, 0, 0, 0x10, 0x27, 0x80, 0, 0};
+        static_assert(VehicleSpeed::Decode(frame) == 10000);
+        static_assert(BrakeState::Decode(frame) == 2);
+        REQUIRE(VehicleSpeed::Phys(frame) == 100.0);
+    }
+}
+TEST_CASE("Decoding: JIT")
+{
+    using namespace dbcppp;
+
+    if (!DecodeJit::Supported())
+    {
+        DecodeJit jit;
+        REQUIRE(!jit.Compile({}));
+        return;
+    }
+    uint32_t seed = static_cast<uint32_t>(time(0));
+    std::default_random_engine rng(seed);
+    std::uniform_int_distribution<std::mt19937::result_type> dist(0, -1);
+
+    SECTION("Random signals")
+    {
+        const double factors[] = {1.0, 0.1, -0.25, 3.0, 1e-3};
+        const double offsets[] = {0.0, -0.0, -40.0, 0.5};
+        for (std::size_t i = 0; i < 500; i++)
+        {
+            std::size_t n_sigs = dist(rng) % 48 + 1;
+            std::vector<std::unique_ptr<ISignal>> sigs;
+            for (std::size_t j = 0; j < n_sigs; j++)
+            {
+                auto sig = generate_random_signal(64, rng);
+                sigs.push_back(ISignal::Create(64, "Signal", ISignal::EMultiplexer::NoMux, 0, sig->StartBit(), sig->BitSize(),
+                    sig->ByteOrder(), sig->ValueType(), factors[dist(rng) % 5], offsets[dist(rng) % 4], 0.0, 0.0, "",
+                    {}, {}, {}, sig->ExtendedValueType(), {}));
+            }
+            auto msg = IMessage::Create(1, "Msg", 64, "", {}, std::move(sigs), {}, {});
+            const DecodePlan& plan = static_cast<const MessageImpl&>(*msg).decodePlan();
+            DecodeJit jit;
+            REQUIRE(jit.Compile({&plan}));
+            REQUIRE(jit.Entry(0) != nullptr);
+            std::vector<double> expected(plan.Size());
+            std::vector<double> values(plan.Size());
+            for (std::size_t n = 0; n < 16; n++)
+            {
+                auto data = generate_random_data(64 + 16, rng);
+                REQUIRE(plan.Decode(data.data(), 64, expected.data()) == plan.Size());
+                jit.Entry(0)(data.data(), values.data());
+                for (std::size_t j = 0; j < plan.Size(); j++)
+                {
+                    const ISignal& sig = msg->Signals_Get(j);
+                    INFO("Seed " << seed << " test " << i << " signal " << j << " StartBit:" << sig.StartBit()
+                        << " BitSize:" << sig.BitSize() << " Factor:" << sig.Factor() << " Offset:" << sig.Offset());
+                    REQUIRE(bits_of(values[j]) == bits_of(expected[j]));
+                }
+            }
+        }
+    }
+    SECTION("Loaded networks")
+    {
+        auto net = INetwork::LoadDBCFromFile((std::string(TEST_FILES_PATH) + "/dbc/Model3CAN.dbc").c_str());
+        REQUIRE(net);
+        REQUIRE(static_cast<NetworkImpl&>(*net).CompileDecoders());
+        for (std::size_t i = 0; i < net->Messages_Size(); i++)
+        {
+            const IMessage& msg = net->Messages_Get(i);
+            REQUIRE(static_cast<const MessageImpl&>(msg).decodePlan().Native() != nullptr);
+            std::vector<double> values(msg.Signals_Size());
+            for (std::size_t len : {std::size_t(3), std::size_t(64)})
+            {
+                auto data = generate_random_data(64 + 16, rng);
+                REQUIRE(msg.DecodeAll(data.data(), len, values.data()) == msg.Signals_Size());
+                std::fill(data.begin() + len, data.end(), 0);
+                for (std::size_t j = 0; j < msg.Signals_Size(); j++)
+                {
+                    const ISignal& sig = msg.Signals_Get(j);
+                    INFO(msg.Name() << "." << sig.Name());
+                    REQUIRE(bits_of(values[j]) == bits_of(sig.RawToPhys(sig.Decode(data.data()))));
+                }
+            }
+        }
+        // copies of a message don't refer to the network's code
+        MessageImpl copy(static_cast<const MessageImpl&>(net->Messages_Get(0)));
+        REQUIRE(copy.decodePlan().Native() == nullptr);
+    }
+}
+TEST_CASE("Decoding: No allocations after loading into static storage")
+{
+    using namespace dbcppp;
+
+    static NetworkStorage<2 * 1024 * 1024> storage;
+    auto result = INetwork::LoadDBCIntoStorage((std::string(TEST_FILES_PATH) + "/dbc/Model3CAN.dbc").c_str(), storage, {});
+    REQUIRE(result.isOk());
+    auto net = result.moveValue();
+
+    uint8_t frames[4][64];
+    for (std::size_t i = 0; i < sizeof(frames); i++)
+    {
+        frames[i / 64][i % 64] = uint8_t(i * 31 + 7);
+    }
+    std::vector<double> values(256);
+    std::vector<std::size_t> indices(256);
+    std::vector<ISignal::raw_t> raws(4);
+    double sum = 0;
+
+    count_allocations = true;
+    allocation_count = 0;
+    for (const IMessage& msg : net->Messages())
+    {
+        if (msg.Signals_Size() > values.size())
+        {
+            continue;
+        }
+        sum += double(msg.DecodeAll(frames[0], sizeof(frames[0]), values.data()));
+        sum += double(msg.DecodeActive(frames[1], 8, indices.data(), values.data()));
+        sum += double(net->FindMessage(msg.Id()) == &msg);
+        for (const ISignal& sig : msg.Signals())
+        {
+            sum += sig.RawToPhys(sig.Decode(frames[2]));
+            sig.DecodeBatch(frames, sizeof(frames[0]), 4, raws.data());
+            sig.DecodeBatch(frames, sizeof(frames[0]), 4, values.data());
+            sum += values[3];
+        }
+    }
+    count_allocations = false;
+    INFO("checksum " << sum);
+    REQUIRE(allocation_count == 0);
+}
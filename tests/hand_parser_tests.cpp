@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include "../src/dbc_parser.h"
+#include "../src/dbc_stream_parser.h"
 #include <sstream>
 #include <fstream>
 #include "config.h"
@@ -64,10 +65,46 @@ TEST_CASE("DBCLexer Basic Token Recognition", "[lexer]") {
         REQUIRE(tokens[1].value == "world with spaces");
         
         REQUIRE(tokens[2].type == TokenType::STRING);
-        REQUIRE(tokens[2].value == "escaped \" quote");
+        REQUIRE(tokens[2].escaped);
+        REQUIRE(tokens[2].value == "escaped \\\" quote");
+        REQUIRE(tokens[2].text() == "escaped \" quote");
         
         REQUIRE(tokens[3].type == TokenType::STRING);
         REQUIRE(tokens[3].value == "empty:");
+        REQUIRE(!tokens[3].escaped);
+    }
+
+    SECTION("Tokens View The Input") {
+        std::string input = "BO_ 0x1FF Msg: 8 ECU";
+        DBCLexer lexer(input);
+        auto tokens = lexer.tokenize();
+
+        REQUIRE(tokens[1].value.data() == input.data() + 4);
+        REQUIRE(parseUnsigned(tokens[1].value, 16) == 0x1FF);
+        REQUIRE(tokens[2].value.data() == input.data() + 10);
+        REQUIRE(parseSigned("-17") == -17);
+        REQUIRE(parseDouble("1.5e3") == 1500.0);
+        REQUIRE(tryParseUnsigned("12ab") == 12u);
+        REQUIRE(tryParseUnsigned("0x", 16) == 0u);
+        REQUIRE(!tryParseUnsigned("abc"));
+        REQUIRE(!tryParseUnsigned("-"));
+        REQUIRE(!tryParseSigned("-x"));
+        REQUIRE(!tryParseDouble("INT"));
+        REQUIRE(!tryParseDouble(""));
+    }
+
+    SECTION("Pull Interface") {
+        DBCLexer lexer("BU_: ECU1 ECU2");
+
+        REQUIRE(lexer.peek().type == TokenType::BU_);
+        REQUIRE(lexer.peek(2).value == "ECU1");
+        REQUIRE(lexer.next().type == TokenType::BU_);
+        REQUIRE(lexer.next().type == TokenType::COLON);
+        REQUIRE(lexer.peek(1).value == "ECU2");
+        REQUIRE(lexer.next().value == "ECU1");
+        REQUIRE(lexer.next().value == "ECU2");
+        REQUIRE(lexer.next().type == TokenType::END_OF_FILE);
+        REQUIRE(lexer.peek().type == TokenType::END_OF_FILE);
     }
     
     SECTION("Identifiers and Multiplexer Indicators") {
@@ -312,6 +349,85 @@ CM_ SG_ 100 TestSignal "Test signal comment";
     REQUIRE(c4.text == "Test signal comment");
 }
 
+TEST_CASE("DBCParser Filter Pushdown", "[parser]") {
+    std::string dbc = R"(
+VERSION ""
+NS_ :
+BS_:
+BU_ ECU1 ECU2
+
+BO_ 100 KeepMsg: 8 ECU1
+ SG_ KeepSignal : 0|16@1+ (1,0) [0|65535] "km;h" ECU2
+ SG_ DropSignal : 16|16@1+ (1,0) [0|65535] "" ECU2
+
+BO_ 200 DropMsg: 8 ECU2
+ SG_ Other : 0|8@1+ (1,0) [0|255] "" ECU1
+
+CM_ BO_ 100 "Kept message";
+CM_ BO_ 200 "Dropped message; with a semicolon
+spanning lines";
+CM_ SG_ 100 DropSignal "Dropped signal";
+BA_ "GenMsgCycleTime" BO_ 200 100;
+BA_ "GenSigStartValue" SG_ 100 KeepSignal 1;
+BA_ "GenSigStartValue" SG_ 100 DropSignal 2;
+VAL_ 200 Other 0 "Off" 1 "On" ;
+VAL_ 100 KeepSignal 0 "Zero" ;
+)";
+    DBCParser parser;
+    parser.setFilters(
+        [](uint32_t id, const std::string&) { return id != 200; },
+        [](const std::string& name, uint32_t) { return name != "DropSignal"; });
+    auto result = parser.parse(dbc);
+    REQUIRE(result.isOk());
+    auto& network = result.value();
+
+    REQUIRE(network->messages.size() == 1);
+    REQUIRE(network->messages[0].name == "KeepMsg");
+    REQUIRE(network->messages[0].signals.size() == 1);
+    REQUIRE(network->messages[0].signals[0].name == "KeepSignal");
+    REQUIRE(network->messages[0].signals[0].unit == "km;h");
+
+    REQUIRE(network->comments.size() == 1);
+    REQUIRE(network->comments[0].text == "Kept message");
+    REQUIRE(network->attribute_values.size() == 1);
+    REQUIRE(network->attribute_values[0].signal_name == "KeepSignal");
+    REQUIRE(network->value_descriptions.size() == 1);
+    REQUIRE(network->value_descriptions[0].object_name == "KeepSignal");
+
+    // a '"' inside a comment of a dropped line or statement must not start a string
+    std::string commented = R"(
+VERSION ""
+NS_ :
+BS_:
+BU_ ECU1 ECU2
+
+BO_ 200 Drop: 8 ECU1
+ SG_ Width : 0|8@1+ (1,0) [0|255] "" ECU2 // it's 5" wide
+
+BO_ 100 Keep: 8 ECU1
+ SG_ Sig : 0|8@1+ (1,0) [0|255] "" ECU2
+
+BO_ 300 Keep2: 8 ECU1
+ SG_ Sig : 0|8@1+ (1,0) [0|255] "" ECU2
+
+VAL_ 200 Width 0 "Off" /* 5" */ 1 "On" ;
+VAL_ 300 Sig 0 "Zero" ;
+)";
+    auto unfiltered = DBCParser().parse(commented);
+    REQUIRE(unfiltered.isOk());
+    REQUIRE(unfiltered.value()->messages.size() == 3);
+
+    DBCParser comment_parser;
+    comment_parser.setFilters([](uint32_t id, const std::string&) { return id != 200; }, nullptr);
+    auto filtered = comment_parser.parse(commented);
+    REQUIRE(filtered.isOk());
+    REQUIRE(filtered.value()->messages.size() == 2);
+    REQUIRE(filtered.value()->messages[0].name == "Keep");
+    REQUIRE(filtered.value()->messages[1].name == "Keep2");
+    REQUIRE(filtered.value()->value_descriptions.size() == 1);
+    REQUIRE(filtered.value()->value_descriptions[0].message_id == 300);
+}
+
 TEST_CASE("DBCParser Signal Byte Order and Sign", "[parser]") {
     std::string dbc = R"(
 VERSION ""
@@ -379,6 +495,18 @@ BO_ 100 Msg: 8 ECU1
     }
 }
 
+TEST_CASE("DBCStreamParser Number Errors", "[parser][error]") {
+    DBCStreamParser parser;
+    REQUIRE(parser.parseString("BO_ abc Msg: 8 ECU\n").isError());
+    REQUIRE(parser.parseString("BO_ 100 Msg: size ECU\n").isError());
+
+    auto result = parser.parseString("BA_DEF_ BO_ \"GenMsgCycleTime\" INT 0 3600000;\n");
+    REQUIRE(result.isOk());
+    REQUIRE(result.value()->attribute_definitions.size() == 1);
+    REQUIRE(result.value()->attribute_definitions[0].min_value == 0.0);
+    REQUIRE(result.value()->attribute_definitions[0].max_value == 3600000.0);
+}
+
 TEST_CASE("DBCParser Complex DBC", "[parser][integration]") {
     std::string dbc = R"(
 VERSION "1.0"
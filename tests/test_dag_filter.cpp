@@ -203,17 +203,9 @@ int main(int argc, char* argv[]) {
 
         // Verify all DAG signals were found
         std::cout << "\nVerifying DAG signals..." << std::endl;
-        std::set<std::string> found_signals;
-        for (uint64_t i = 0; i < network_filtered->Messages_Size(); i++) {
-            const auto& msg = network_filtered->Messages_Get(i);
-            for (uint64_t j = 0; j < msg.Signals_Size(); j++) {
-                found_signals.insert(msg.Signals_Get(j).Name());
-            }
-        }
-
         int missing = 0;
         for (const auto& required : dag_signals) {
-            if (found_signals.count(required) == 0) {
+            if (network_filtered->FindSignal(required).empty()) {
                 std::cout << "  WARNING: Signal '" << required << "' not found in DBC" << std::endl;
                 missing++;
             }
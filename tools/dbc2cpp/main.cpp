@@ -0,0 +1,398 @@
+// dbc2cpp: generates a header with compile time decoders for a fixed DBC
+//
+//     dbc2cpp <input.dbc> <output.h> [namespace]
+//
+// The DBC is loaded like at runtime (DBCParser, DBCAST2Network) and every message becomes a
+// struct with one nested struct per signal. A signal's Raw() is the template_decode variant
+// the runtime selects for it with positions, mask and sign shift as literals, Phys() scales
+// like RawToPhys. The namespace level Decode()/DecodeRaw() switch on the CAN ID.
+
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "dbcppp-tiny/network.h"
+#include "signal_impl.h"
+
+using namespace dbcppp;
+
+namespace
+{
+    const char* const reserved[] = {
+        "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+        "case", "catch", "char", "char16_t", "char32_t", "class", "compl", "const", "const_cast",
+        "constexpr", "continue", "decltype", "default", "delete", "do", "double", "dynamic_cast",
+        "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto",
+        "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+        "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register",
+        "reinterpret_cast", "return", "short", "signed", "sizeof", "static", "static_assert",
+        "static_cast", "struct", "switch", "template", "this", "thread_local", "throw", "true",
+        "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void",
+        "volatile", "wchar_t", "while", "xor", "xor_eq"
+    };
+
+    // C++ identifier for a DBC name, unique within used
+    std::string Identifier(const std::string& name, std::set<std::string>& used)
+    {
+        std::string id;
+        for (char c : name)
+        {
+            bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+            id += valid ? c : '_';
+        }
+        if (id.empty() || (id[0] >= '0' && id[0] <= '9'))
+        {
+            id = "s_" + id;
+        }
+        if (std::find(std::begin(reserved), std::end(reserved), id) != std::end(reserved))
+        {
+            id += '_';
+        }
+        std::string unique = id;
+        for (std::size_t i = 2; used.count(unique); i++)
+        {
+            unique = id + "_" + std::to_string(i);
+        }
+        used.insert(unique);
+        return unique;
+    }
+    std::string Quoted(const std::string& str)
+    {
+        std::string result = "\"";
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                result += '\\';
+                result += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\%03o", unsigned(static_cast<unsigned char>(c)));
+                result += buf;
+            }
+            else
+            {
+                result += c;
+            }
+        }
+        return result + "\"";
+    }
+    // literal which converts back to exactly v
+    std::string Literal(double v)
+    {
+        if (std::isnan(v))
+        {
+            return "std::numeric_limits<double>::quiet_NaN()";
+        }
+        if (std::isinf(v))
+        {
+            return v < 0 ? "-std::numeric_limits<double>::infinity()" : "std::numeric_limits<double>::infinity()";
+        }
+        char buf[40];
+        std::snprintf(buf, sizeof(buf), "%.17g", v);
+        std::string result = buf;
+        if (result.find_first_of(".e") == std::string::npos)
+        {
+            result += ".0";
+        }
+        return result;
+    }
+    std::string Hex(uint64_t v)
+    {
+        char buf[24];
+        std::snprintf(buf, sizeof(buf), "0x%llxull", static_cast<unsigned long long>(v));
+        return buf;
+    }
+    std::string At(uint64_t byte_pos)
+    {
+        return byte_pos == 0 ? "data" : "data + " + std::to_string(byte_pos);
+    }
+
+    // expression for template_decode of sig with its precomputed values folded in
+    std::string RawExpression(const SignalImpl& sig)
+    {
+        bool be = sig.ByteOrder() == ISignal::EByteOrder::BigEndian;
+        std::string load64 = be ? "detail::load_be64" : "detail::load_le64";
+        std::string s0 = std::to_string(sig._fixed_start_bit_0);
+        std::string s1 = std::to_string(sig._fixed_start_bit_1);
+        std::string mask = Hex(sig._mask);
+        std::string raw;
+        switch (sig._alignment)
+        {
+        case Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit:
+        {
+            std::string last = "uint64_t(data[" + std::to_string(sig._byte_pos + 8) + "])";
+            raw = be
+                ? "((" + load64 + "(" + At(sig._byte_pos) + ") & " + mask + ") << " + s0 + ") | (" + last + " >> " + s1 + ")"
+                : "(" + load64 + "(" + At(sig._byte_pos) + ") >> " + s0 + ") | ((" + last + " & " + mask + ") << " + s1 + ")";
+            break;
+        }
+        case Alignment::signal_fits_into_32_bit:
+            raw = "(uint64_t(" + std::string(be ? "detail::load_be32" : "detail::load_le32") + "(" + At(sig._byte_pos) + ")) >> " + s0 + ") & " + mask;
+            break;
+        default:
+        {
+            uint64_t byte_pos = sig._alignment == Alignment::size_inbetween_first_64_bit ? 0 : sig._byte_pos;
+            if (sig.ExtendedValueType() == ISignal::EExtendedValueType::Double)
+            {
+                return load64 + "(" + At(byte_pos) + ")";
+            }
+            raw = "(" + load64 + "(" + At(byte_pos) + ") >> " + s0 + ") & " + mask;
+            break;
+        }
+        }
+        if (sig.ExtendedValueType() == ISignal::EExtendedValueType::Integer &&
+            sig.ValueType() == ISignal::EValueType::Signed && sig._sign_shift != 0)
+        {
+            raw = "detail::sign_extend(" + raw + ", " + std::to_string(sig._sign_shift) + ")";
+        }
+        return raw;
+    }
+    // bytes the expression reads
+    uint64_t Extent(const SignalImpl& sig)
+    {
+        switch (sig._alignment)
+        {
+        case Alignment::size_inbetween_first_64_bit:                                    return 8;
+        case Alignment::signal_exceeds_64_bit_size_but_signal_fits_into_64_bit:         return sig._byte_pos + 8;
+        case Alignment::signal_exceeds_64_bit_size_and_signal_does_not_fit_into_64_bit: return sig._byte_pos + 9;
+        case Alignment::signal_fits_into_32_bit:                                        return sig._byte_pos + 4;
+        }
+        return 8;
+    }
+    std::string PhysExpression(const ISignal& sig)
+    {
+        std::string draw;
+        switch (sig.ExtendedValueType())
+        {
+        case ISignal::EExtendedValueType::Integer:
+            draw = sig.ValueType() == ISignal::EValueType::Signed ? "double(int64_t(raw))" : "double(raw)";
+            break;
+        case ISignal::EExtendedValueType::Float:
+            draw = "double(detail::to_float(raw))";
+            break;
+        case ISignal::EExtendedValueType::Double:
+            draw = "detail::to_double(raw)";
+            break;
+        }
+        return draw + " * " + Literal(sig.Factor()) + " + " + Literal(sig.Offset());
+    }
+
+    const char* preamble = R"(#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace @NS@
+{
+    struct SignalDescriptor
+    {
+        const char* name;
+        uint64_t start_bit;
+        uint64_t bit_size;
+        bool big_endian;
+        bool is_signed;
+        // 0: integer, 1: float, 2: double
+        uint8_t extended_value_type;
+        // 0: none, 1: multiplexer switch, 2: multiplexed by multiplexer_switch_value
+        uint8_t multiplexer;
+        uint64_t multiplexer_switch_value;
+        double factor;
+        double offset;
+        double minimum;
+        double maximum;
+        const char* unit;
+    };
+
+    namespace detail
+    {
+        // byte wise loads, independent of host byte order and alignment, compilers fold them into one load
+        constexpr uint64_t load_le64(const uint8_t* p) noexcept
+        {
+            uint64_t v = 0;
+            for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+            return v;
+        }
+        constexpr uint64_t load_be64(const uint8_t* p) noexcept
+        {
+            uint64_t v = 0;
+            for (int i = 0; i < 8; i++) v = (v << 8) | p[i];
+            return v;
+        }
+        constexpr uint32_t load_le32(const uint8_t* p) noexcept
+        {
+            return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+        }
+        constexpr uint32_t load_be32(const uint8_t* p) noexcept
+        {
+            return uint32_t(p[3]) | uint32_t(p[2]) << 8 | uint32_t(p[1]) << 16 | uint32_t(p[0]) << 24;
+        }
+        constexpr uint64_t sign_extend(uint64_t raw, unsigned shift) noexcept
+        {
+            return uint64_t(int64_t(raw << shift) >> shift);
+        }
+        inline float to_float(uint64_t raw) noexcept
+        {
+            uint32_t raw32 = uint32_t(raw);
+            float f;
+            std::memcpy(&f, &raw32, sizeof(f));
+            return f;
+        }
+        inline double to_double(uint64_t raw) noexcept
+        {
+            double d;
+            std::memcpy(&d, &raw, sizeof(d));
+            return d;
+        }
+    }
+)";
+
+    void Generate(const INetwork& net, const std::string& source, const std::string& ns, std::ostream& os)
+    {
+        std::string head = preamble;
+        head.replace(head.find("@NS@"), 4, ns);
+        os << "// Generated by dbc2cpp from " << source << ", do not edit.\n"
+           << "// Raw() of a signal returns what ISignal::Decode returns, Phys() what RawToPhys returns.\n"
+           << "// Frames passed to Raw() and Decode() have to hold at least the message's extent bytes.\n"
+           << head;
+
+        std::set<std::string> used_messages = {"SignalDescriptor", "detail", "Decode", "DecodeRaw"};
+        std::set<uint64_t> ids;
+        std::ostringstream decode;
+        std::ostringstream decode_raw;
+        for (const IMessage& msg : net.Messages())
+        {
+            std::string msg_id = Identifier(msg.Name(), used_messages);
+            std::set<std::string> used = {msg_id, "id", "name", "size", "extent", "signal_count", "Decode", "DecodeRaw"};
+            std::ostringstream signals;
+            std::ostringstream decode_all;
+            std::ostringstream decode_all_raw;
+            uint64_t extent = 8;
+            std::size_t i = 0;
+            for (const ISignal& sig : msg.Signals())
+            {
+                const auto& sigi = static_cast<const SignalImpl&>(sig);
+                std::string sig_id = Identifier(sig.Name(), used);
+                extent = std::max(extent, Extent(sigi));
+                signals
+                    << "        struct " << sig_id << "\n"
+                    << "        {\n"
+                    << "            static constexpr SignalDescriptor descriptor = {" << Quoted(sig.Name())
+                        << ", " << sig.StartBit() << ", " << sig.BitSize()
+                        << ", " << (sig.ByteOrder() == ISignal::EByteOrder::BigEndian ? "true" : "false")
+                        << ", " << (sig.ValueType() == ISignal::EValueType::Signed ? "true" : "false")
+                        << ", " << int(sig.ExtendedValueType()) << ", " << int(sig.MultiplexerIndicator())
+                        << ", " << sig.MultiplexerSwitchValue()
+                        << ", " << Literal(sig.Factor()) << ", " << Literal(sig.Offset())
+                        << ", " << Literal(sig.Minimum()) << ", " << Literal(sig.Maximum())
+                        << ", " << Quoted(sig.Unit()) << "};\n"
+                    << "            static constexpr uint64_t Raw(const uint8_t* data) noexcept\n"
+                    << "            {\n"
+                    << "                return " << RawExpression(sigi) << ";\n"
+                    << "            }\n"
+                    << "            static inline double Phys(uint64_t raw) noexcept\n"
+                    << "            {\n"
+                    << "                return " << PhysExpression(sig) << ";\n"
+                    << "            }\n"
+                    << "        };\n";
+                decode_all << "            out[" << i << "] = " << sig_id << "::Phys(" << sig_id << "::Raw(data));\n";
+                decode_all_raw << "            out[" << i << "] = " << sig_id << "::Raw(data);\n";
+                i++;
+            }
+            os << "\n"
+               << "    // BO_ " << msg.Id() << " " << msg.Name() << ": " << msg.MessageSize() << "\n"
+               << "    struct " << msg_id << "\n"
+               << "    {\n"
+               << "        static constexpr uint64_t id = " << Hex(msg.Id()) << ";\n"
+               << "        static constexpr const char* name = " << Quoted(msg.Name()) << ";\n"
+               << "        static constexpr std::size_t size = " << msg.MessageSize() << ";\n"
+               << "        static constexpr std::size_t extent = " << extent << ";\n"
+               << "        static constexpr std::size_t signal_count = " << msg.Signals_Size() << ";\n"
+               << "\n"
+               << signals.str()
+               << "\n"
+               << "        // physical values of all signals in signal order\n"
+               << "        static inline void Decode(const uint8_t* data, double* out) noexcept\n"
+               << "        {\n"
+               << decode_all.str()
+               << "        }\n"
+               << "        static inline void DecodeRaw(const uint8_t* data, uint64_t* out) noexcept\n"
+               << "        {\n"
+               << decode_all_raw.str()
+               << "        }\n"
+               << "    };\n";
+            if (!ids.insert(msg.Id()).second)
+            {
+                // like FindMessage, the first message with an ID wins
+                continue;
+            }
+            decode << "        case " << msg_id << "::id: " << msg_id << "::Decode(data, out); return " << msg_id << "::signal_count;\n";
+            decode_raw << "        case " << msg_id << "::id: " << msg_id << "::DecodeRaw(data, out); return " << msg_id << "::signal_count;\n";
+        }
+        os << "\n"
+           << "    // Decodes the message with this CAN ID (as in the DBC, bit 31 set for extended IDs) like\n"
+           << "    // IMessage::DecodeAll. Returns the number of values written, 0 for IDs not in the DBC.\n"
+           << "    inline std::size_t Decode(uint64_t id, const uint8_t* data, double* out) noexcept\n"
+           << "    {\n"
+           << "        switch (id)\n"
+           << "        {\n"
+           << decode.str()
+           << "        }\n"
+           << "        return 0;\n"
+           << "    }\n"
+           << "    inline std::size_t DecodeRaw(uint64_t id, const uint8_t* data, uint64_t* out) noexcept\n"
+           << "    {\n"
+           << "        switch (id)\n"
+           << "        {\n"
+           << decode_raw.str()
+           << "        }\n"
+           << "        return 0;\n"
+           << "    }\n"
+           << "}\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3 || argc > 4)
+    {
+        std::fprintf(stderr, "usage: %s <input.dbc> <output.h> [namespace]\n", argv[0]);
+        return 2;
+    }
+    std::string ns = argc == 4 ? argv[3] : "dbc";
+    auto net = INetwork::LoadDBCFromFile(argv[1]);
+    if (!net)
+    {
+        std::fprintf(stderr, "%s: cannot load %s\n", argv[0], argv[1]);
+        return 1;
+    }
+    std::ostringstream os;
+    Generate(*net, argv[1], ns, os);
+    // only touch the output if it changed, so dependents aren't rebuilt needlessly
+    std::string text = os.str();
+    {
+        std::ifstream in(argv[2], std::ios::binary);
+        std::ostringstream old;
+        old << in.rdbuf();
+        if (in && old.str() == text)
+        {
+            return 0;
+        }
+    }
+    std::ofstream out(argv[2], std::ios::binary);
+    out << text;
+    if (!out)
+    {
+        std::fprintf(stderr, "%s: cannot write %s\n", argv[0], argv[2]);
+        return 1;
+    }
+    return 0;
+}